@@ -0,0 +1,218 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <optional>
+#include <fmt/format.h>
+#include "work_stealing_pool.h"
+#include "aco_evaluation.h"
+
+// Hyperband autotuner: runs successive-halving brackets that start many random configurations on
+// small task subsets with few iterations and promote the best third (eta = 3) to the next rung,
+// up to the full workload. Every evaluation checks the wall-clock deadline, so the tuner stops
+// within the budget and reports the best configuration found at the largest size reached.
+class HyperbandAutotuner {
+public:
+    static constexpr int ETA = 3;
+
+    HyperbandAutotuner(const std::vector<double>& workload, const std::vector<int>& capabilities, int maxIterations,
+                       int minTasks, WorkStealingPool& pool, uint64_t seed)
+        : workload(workload), capabilities(capabilities), maxIterations(maxIterations), minTasks(minTasks),
+          pool(pool), gen(seed), seed(seed) {}
+
+    void run(std::chrono::steady_clock::duration budget) {
+        deadline = std::chrono::steady_clock::now() + budget;
+
+        // Smallest rung: the full workload divided by ETA^maxBracket, but at least minTasks tasks
+        int maxBracket = 0;
+        while (int(workload.size()) / std::pow(ETA, maxBracket + 1) >= minTasks) {
+            ++maxBracket;
+        }
+
+        for (int bracket = maxBracket; bracket >= 0 && !isOverBudget(); --bracket) {
+            int numCandidates = std::ceil(double(maxBracket + 1) / (bracket + 1) * std::pow(ETA, bracket));
+            std::vector<AntColonyParameters> candidates(numCandidates);
+            for (auto& candidate : candidates) {
+                candidate = sampleParameters();
+            }
+
+            for (int rung = 0; rung <= bracket && !candidates.empty(); ++rung) {
+                double fraction = std::pow(ETA, rung - bracket);
+                int numTasks = std::max(minTasks, int(std::lround(fraction * workload.size())));
+                int numIterations = std::max(1, int(std::lround(fraction * maxIterations)));
+                std::vector<std::optional<Evaluation>> evaluations = evaluateRung(candidates, numTasks, numIterations);
+
+                std::vector<int> order;
+                for (int i = 0; i < int(candidates.size()); ++i) {
+                    if (evaluations[i]) {
+                        order.push_back(i);
+                        record(candidates[i], *evaluations[i], numTasks, numIterations);
+                    }
+                }
+                std::sort(order.begin(), order.end(), [&](int a, int b) {
+                    return evaluations[a]->makespanRatio < evaluations[b]->makespanRatio;
+                });
+
+                rungs.push_back({bracket, rung, int(candidates.size()), int(order.size()), numTasks, numIterations,
+                                 order.empty() ? INFINITY : evaluations[order[0]]->makespanRatio});
+
+                // Promote the best 1/ETA of the rung
+                std::vector<AntColonyParameters> promoted;
+                for (int i = 0; i < int(order.size()) && i < int(candidates.size()) / ETA; ++i) {
+                    promoted.push_back(candidates[order[i]]);
+                }
+                candidates = promoted;
+            }
+        }
+    }
+
+    void printReport() const {
+        std::cout << std::setw(10) << "Bracket" << std::setw(8) << "Rung" << std::setw(12) << "Candidates"
+                  << std::setw(12) << "Evaluated" << std::setw(10) << "Tasks" << std::setw(12) << "Iterations"
+                  << std::setw(16) << "Best Ratio" << std::endl;
+        for (const auto& rung : rungs) {
+            std::cout << std::setw(10) << rung.bracket << std::setw(8) << rung.rung << std::setw(12) << rung.candidates
+                      << std::setw(12) << rung.evaluated << std::setw(10) << rung.numTasks << std::setw(12)
+                      << rung.numIterations << std::setw(16) << rung.bestRatio << std::endl;
+        }
+        std::cout << std::endl;
+
+        std::cout << std::setw(28) << "Evaluations" << std::setw(20) << numEvaluations << std::endl;
+        std::cout << std::setw(28) << "Compute Spent (μs)" << std::setw(20) << computeSpent << std::endl;
+        std::cout << std::setw(28) << "Compute Spent (ant-steps)" << std::setw(20) << antStepsSpent << std::endl;
+        if (!best) {
+            std::cout << std::setw(28) << "Best Configuration" << std::setw(20) << "none" << std::endl;
+            return;
+        }
+        std::cout << std::setw(28) << "Best alpha" << std::setw(20) << best->parameters.alpha << std::endl;
+        std::cout << std::setw(28) << "Best beta" << std::setw(20) << best->parameters.beta << std::endl;
+        std::cout << std::setw(28) << "Best rho" << std::setw(20) << best->parameters.rho << std::endl;
+        std::cout << std::setw(28) << "Best Q" << std::setw(20) << best->parameters.Q << std::endl;
+        std::cout << std::setw(28) << "Best Iterations" << std::setw(20) << best->numIterations << std::endl;
+        std::cout << std::setw(28) << "Evaluated On (tasks)" << std::setw(20) << best->numTasks << std::endl;
+        std::cout << std::setw(28) << "Makespan Ratio" << std::setw(20) << best->makespanRatio << std::endl;
+    }
+
+private:
+    struct RungSummary {
+        int bracket;
+        int rung;
+        int candidates;
+        int evaluated;
+        int numTasks;
+        int numIterations;
+        double bestRatio;
+    };
+
+    struct Incumbent {
+        AntColonyParameters parameters;
+        int numTasks;
+        int numIterations;
+        double makespanRatio;
+    };
+
+    const std::vector<double>& workload;
+    const std::vector<int>& capabilities;
+    int maxIterations;
+    int minTasks;
+    WorkStealingPool& pool;
+    std::mt19937_64 gen;
+    uint64_t seed;
+    std::chrono::steady_clock::time_point deadline;
+    std::vector<RungSummary> rungs;
+    std::optional<Incumbent> best;
+    int numEvaluations = 0;
+    double computeSpent = 0;
+    long long antStepsSpent = 0;
+
+    bool isOverBudget() const {
+        return std::chrono::steady_clock::now() >= deadline;
+    }
+
+    // Log-uniform for the scale parameters, uniform for the evaporation rate
+    AntColonyParameters sampleParameters() {
+        auto logUniform = [this](double low, double high) {
+            return std::exp(std::uniform_real_distribution<>(std::log(low), std::log(high))(gen));
+        };
+        AntColonyParameters parameters;
+        parameters.alpha = logUniform(0.25, 4.0);
+        parameters.beta = logUniform(0.5, 8.0);
+        parameters.rho = std::uniform_real_distribution<>(0.05, 0.95)(gen);
+        parameters.Q = logUniform(0.05, 20.0);
+        return parameters;
+    }
+
+    // Evaluates a rung in parallel; evaluations that would start after the deadline are skipped
+    std::vector<std::optional<Evaluation>> evaluateRung(const std::vector<AntColonyParameters>& candidates,
+                                                        int numTasks, int numIterations) {
+        std::vector<std::optional<Evaluation>> evaluations(candidates.size());
+        WorkStealingPool::TaskGroup group(pool);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            group.run([&, i] {
+                if (isOverBudget()) return;
+                AntColonyParameters parameters = candidates[i];
+                parameters.numIterations = numIterations;
+                evaluations[i] = evaluate(parameters, std::vector<double>(workload.begin(), workload.begin() + numTasks),
+                                          capabilities, seed);
+            });
+        }
+        group.wait();
+        return evaluations;
+    }
+
+    // Keeps the best configuration seen at the largest workload size reached so far
+    void record(const AntColonyParameters& parameters, const Evaluation& evaluation, int numTasks, int numIterations) {
+        ++numEvaluations;
+        computeSpent += evaluation.duration;
+        antStepsSpent += evaluation.antSteps;
+        if (!best || numTasks > best->numTasks ||
+            (numTasks == best->numTasks && evaluation.makespanRatio < best->makespanRatio)) {
+            best = Incumbent{parameters, numTasks, numIterations, evaluation.makespanRatio};
+            best->parameters.numIterations = numIterations;
+        }
+    }
+};
+
+int main(int argc, char** argv) {
+    const int NUM_TASKS = 1000;
+    const int NUM_SERVERS = 50;
+    const int MAX_ITERATIONS = 100;
+    const int MIN_TASKS = 30;
+    const uint64_t WORKLOAD_SEED = 42;
+    double budgetSeconds = argc > 1 ? std::stod(argv[1]) : 30.0;
+    int numThreads = argc > 2 ? std::stoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<double> workload;
+    std::vector<int> capabilities;
+    generateWorkload(WORKLOAD_SEED, NUM_TASKS, NUM_SERVERS, workload, capabilities);
+
+    WorkStealingPool pool(numThreads);
+    HyperbandAutotuner tuner(workload, capabilities, MAX_ITERATIONS, MIN_TASKS, pool, WORKLOAD_SEED);
+
+    auto startTime = std::chrono::steady_clock::now();
+    tuner.run(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(budgetSeconds)));
+    auto endTime = std::chrono::steady_clock::now();
+
+    std::cout << std::setw(28) << "Budget (s)" << std::setw(20) << budgetSeconds << std::endl;
+    std::cout << std::setw(28) << "Wall Time (s)" << std::setw(20)
+              << std::chrono::duration<double>(endTime - startTime).count() << std::endl;
+    std::cout << std::setw(28) << "Threads" << std::setw(20) << numThreads << std::endl;
+    std::cout << std::endl;
+    tuner.printReport();
+
+    // Reference point: the default parameters at full size
+    Evaluation defaults = evaluate(AntColonyParameters{}, workload, capabilities, WORKLOAD_SEED);
+    std::cout << std::setw(28) << "Default Makespan Ratio" << std::setw(20) << defaults.makespanRatio << std::endl;
+
+    std::cout << std::endl;
+    pool.printUtilization();
+
+    return 0;
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include "tracing.h"
+
+// ACO pieces shared by the parameter sweep and the autotuner: the seeded algorithm, the workload
+// generator and the evaluation of one configuration, so that both drivers score a configuration
+// the same way.
+
+// Server class
+class Server {
+public:
+    Server(int id, int capability) : id(id), capability(capability), load(0) {}
+
+    void addLoad(double taskLoad) {
+        load += taskLoad;
+    }
+
+    void resetLoad() {
+        load = 0;
+    }
+
+    double getLoad() const {
+        return load;
+    }
+
+    int getId() const {
+        return id;
+    }
+
+    int getCapability() const {
+        return capability;
+    }
+
+private:
+    int id;
+    int capability;
+    double load;
+};
+
+// Ant Colony Optimization parameters
+struct AntColonyParameters {
+    double alpha = 1.0;      // Pheromone importance factor
+    double beta = 2.0;       // Heuristic information importance factor
+    double rho = 0.5;        // Pheromone evaporation rate
+    double Q = 1.0;          // Pheromone deposit quantity
+    int numIterations = 100;
+};
+
+// Ant Colony Optimization algorithm with runtime parameters and a seeded generator, so that a
+// (parameters, seed, workload) triple always produces the same assignment
+class AntColonyOptimizationLoadBalancing {
+public:
+    AntColonyOptimizationLoadBalancing(std::vector<Server>& servers, AntColonyParameters parameters, uint64_t seed)
+        : servers(servers), parameters(parameters), gen(seed) {}
+
+    void balanceLoad(const std::vector<double>& taskLoads) {
+        int numTasks = taskLoads.size();
+        int numServers = servers.size();
+
+        // Initialize pheromone trails
+        std::vector<std::vector<double>> pheromones(numTasks, std::vector<double>(numServers, 1.0));
+
+        // Ants work on tentative loads (work per unit of capability); the best assignment is kept
+        std::vector<int> assignment(numTasks);
+        std::vector<int> bestAssignment(numTasks);
+        double bestMaxLoad = INFINITY;
+
+        for (int iteration = 0; iteration < parameters.numIterations; ++iteration) {
+            TRACE_SCOPE("aco.iteration", iteration);
+            std::vector<double> loads(numServers, 0.0);
+
+            // Move ants
+            for (int taskId = 0; taskId < numTasks; ++taskId) {
+                int currentServer = selectNextServer(taskId, pheromones, loads, taskLoads);
+                loads[currentServer] += taskLoads[taskId] / servers[currentServer].getCapability();
+                assignment[taskId] = currentServer;
+            }
+
+            double maxLoad = *std::max_element(loads.begin(), loads.end());
+            if (maxLoad < bestMaxLoad) {
+                bestMaxLoad = maxLoad;
+                bestAssignment = assignment;
+            }
+
+            // Update pheromones
+            TRACE_SCOPE("aco.updatePheromones");
+            updatePheromones(pheromones, loads, taskLoads);
+        }
+
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            servers[bestAssignment[taskId]].addLoad(taskLoads[taskId]);
+        }
+    }
+
+private:
+    std::vector<Server>& servers;
+    AntColonyParameters parameters;
+    std::mt19937_64 gen;
+
+    int selectNextServer(int taskId, const std::vector<std::vector<double>>& pheromones, const std::vector<double>& loads,
+                         const std::vector<double>& taskLoads) {
+        int numServers = servers.size();
+
+        // Calculate selection probabilities
+        std::vector<double> probabilities(numServers, 0.0);
+        double totalProbability = 0.0;
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            double pheromone = pheromones[taskId][serverId];
+            double taskTime = taskLoads[taskId] / servers[serverId].getCapability();
+            double heuristic = 1.0 / (std::pow(loads[serverId] + taskTime, parameters.beta));
+            probabilities[serverId] = std::pow(pheromone, parameters.alpha) * heuristic;
+            totalProbability += probabilities[serverId];
+        }
+
+        // Roulette wheel selection
+        std::uniform_real_distribution<> dis(0.0, totalProbability);
+        double selection = dis(gen);
+        double cumulativeProbability = 0.0;
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            cumulativeProbability += probabilities[serverId];
+            if (cumulativeProbability >= selection) {
+                return serverId;
+            }
+        }
+
+        // If no server is selected, return the last server
+        return numServers - 1;
+    }
+
+    void updatePheromones(std::vector<std::vector<double>>& pheromones, const std::vector<double>& loads,
+                          const std::vector<double>& taskLoads) {
+        int numTasks = taskLoads.size();
+        int numServers = servers.size();
+
+        // Evaporate pheromones
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            for (int serverId = 0; serverId < numServers; ++serverId) {
+                pheromones[taskId][serverId] *= (1.0 - parameters.rho);
+            }
+        }
+
+        // Deposit pheromones based on server loads
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            for (int serverId = 0; serverId < numServers; ++serverId) {
+                double taskTime = taskLoads[taskId] / servers[serverId].getCapability();
+                double deltaPheromone = parameters.Q / (loads[serverId] + taskTime);
+                pheromones[taskId][serverId] += deltaPheromone;
+            }
+        }
+    }
+};
+
+// Result of evaluating one configuration on one workload
+struct Evaluation {
+    double makespanRatio; // Makespan over the capability-proportional lower bound (1.0 is perfect)
+    double duration;      // Execution time of the ACO run in microseconds
+    long long antSteps;   // Server probabilities computed: tasks x servers x iterations
+};
+
+// Helper function to generate the workload of one seed: task loads and server capabilities
+inline void generateWorkload(uint64_t seed, int numTasks, int numServers, std::vector<double>& taskLoads,
+                             std::vector<int>& capabilities) {
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<> loadDis(1.0, 10.0);
+    std::uniform_int_distribution<> capabilityDis(1, 100);
+    taskLoads.resize(numTasks);
+    for (int i = 0; i < numTasks; ++i) {
+        taskLoads[i] = loadDis(gen);
+    }
+    capabilities.resize(numServers);
+    for (int i = 0; i < numServers; ++i) {
+        capabilities[i] = capabilityDis(gen);
+    }
+}
+
+// Helper function to run ACO with the given parameters and seed on a workload and score the result
+inline Evaluation evaluate(const AntColonyParameters& parameters, const std::vector<double>& taskLoads,
+                           const std::vector<int>& capabilities, uint64_t seed) {
+    std::vector<Server> servers;
+    for (int i = 0; i < int(capabilities.size()); ++i) {
+        servers.push_back(Server(i, capabilities[i]));
+    }
+
+    AntColonyOptimizationLoadBalancing algorithm(servers, parameters, seed);
+    auto startTime = std::chrono::steady_clock::now();
+    algorithm.balanceLoad(taskLoads);
+    auto endTime = std::chrono::steady_clock::now();
+
+    double totalLoad = 0.0;
+    double totalCapability = 0.0;
+    double makespan = 0.0;
+    for (const auto& server : servers) {
+        totalLoad += server.getLoad();
+        totalCapability += server.getCapability();
+        makespan = std::max(makespan, server.getLoad() / server.getCapability());
+    }
+    return {makespan / (totalLoad / totalCapability),
+            double(std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count()),
+            (long long)taskLoads.size() * (long long)servers.size() * parameters.numIterations};
+}
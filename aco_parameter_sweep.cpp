@@ -0,0 +1,202 @@
+#include <iostream>
+#include <vector>
+#include <map>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <fmt/format.h>
+#include "work_stealing_pool.h"
+#include "tracing.h"
+#include "aco_evaluation.h"
+
+// Result of evaluating one sweep cell
+struct SweepResult {
+    double makespanRatio; // Makespan over the capability-proportional lower bound (1.0 is perfect)
+    double duration;      // Execution time of the ACO run in microseconds
+};
+
+// On-disk result cache: one "key|makespanRatio duration" line per evaluated cell. The key covers
+// the parameters, the workload seed and the problem sizes, so any change re-evaluates the cell.
+class ResultCache {
+public:
+    ResultCache(const std::string& path) : path(path) {
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line)) {
+            size_t separator = line.find('|');
+            if (separator == std::string::npos) continue;
+            std::istringstream values(line.substr(separator + 1));
+            SweepResult result;
+            if (values >> result.makespanRatio >> result.duration) {
+                results[line.substr(0, separator)] = result;
+            }
+        }
+    }
+
+    static std::string makeKey(const AntColonyParameters& parameters, uint64_t seed, int numTasks, int numServers) {
+        std::ostringstream key;
+        key << std::setprecision(17) << parameters.alpha << ' ' << parameters.beta << ' ' << parameters.rho << ' '
+            << parameters.Q << ' ' << parameters.numIterations << ' ' << seed << ' ' << numTasks << ' ' << numServers;
+        return key.str();
+    }
+
+    bool find(const std::string& key, SweepResult& result) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = results.find(key);
+        if (it == results.end()) {
+            return false;
+        }
+        result = it->second;
+        return true;
+    }
+
+    // Stores a result and appends it to the file right away, so an interrupted sweep keeps its work
+    void store(const std::string& key, const SweepResult& result) {
+        std::lock_guard<std::mutex> lock(mutex);
+        results[key] = result;
+        std::ofstream out(path, std::ios::app);
+        out << key << '|' << std::setprecision(17) << result.makespanRatio << ' ' << result.duration << '\n';
+    }
+
+private:
+    std::string path;
+    std::map<std::string, SweepResult> results;
+    std::mutex mutex;
+};
+
+// Helper function to evaluate one sweep cell on the workload of its seed
+SweepResult evaluateCell(const AntColonyParameters& parameters, uint64_t seed, int numTasks, int numServers) {
+    std::vector<double> taskLoads;
+    std::vector<int> capabilities;
+    generateWorkload(seed, numTasks, numServers, taskLoads, capabilities);
+    Evaluation evaluation = evaluate(parameters, taskLoads, capabilities, seed);
+    return {evaluation.makespanRatio, evaluation.duration};
+}
+
+// Helper function to build the parameter grid
+std::vector<AntColonyParameters> buildGrid(const std::vector<double>& alphas, const std::vector<double>& betas,
+                                           const std::vector<double>& rhos, const std::vector<double>& Qs,
+                                           const std::vector<int>& iterations) {
+    std::vector<AntColonyParameters> grid;
+    for (double alpha : alphas) {
+        for (double beta : betas) {
+            for (double rho : rhos) {
+                for (double Q : Qs) {
+                    for (int numIterations : iterations) {
+                        grid.push_back({alpha, beta, rho, Q, numIterations});
+                    }
+                }
+            }
+        }
+    }
+    return grid;
+}
+
+int main(int argc, char** argv) {
+    const int NUM_TASKS = 200;
+    const int NUM_SERVERS = 20;
+    const uint64_t WORKLOAD_SEED = 42;
+    const int TOP_RESULTS = 10;
+    std::string cachePath = argc > 1 ? argv[1] : "aco_sweep_cache.txt";
+    int numThreads = argc > 2 ? std::stoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    // Optional Chrome trace of the sweep
+    std::string tracePath = argc > 3 ? argv[3] : "";
+    if (!tracePath.empty()) {
+        tracing::Tracer::get().start(tracePath);
+        tracing::Tracer::get().setThreadName("Main");
+    }
+
+    std::vector<AntColonyParameters> grid =
+        buildGrid({0.5, 1.0, 2.0}, {1.0, 2.0, 4.0}, {0.1, 0.5, 0.9}, {0.1, 1.0, 10.0}, {10, 50});
+
+    ResultCache cache(cachePath);
+    std::vector<SweepResult> results(grid.size());
+    std::atomic<int> cachedCells = 0;
+
+    // Cells differ several-fold in cost (iterations, and cache hits cost nothing), so the pool
+    // steals to keep every worker busy until the last cell
+    WorkStealingPool pool(numThreads);
+    auto startTime = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool::TaskGroup group(pool);
+        for (size_t cell = 0; cell < grid.size(); ++cell) {
+            group.run([&, cell] {
+                TRACE_SCOPE("sweep.cell", int(cell));
+                std::string key = ResultCache::makeKey(grid[cell], WORKLOAD_SEED, NUM_TASKS, NUM_SERVERS);
+                if (cache.find(key, results[cell])) {
+                    ++cachedCells;
+                    return;
+                }
+                results[cell] = evaluateCell(grid[cell], WORKLOAD_SEED, NUM_TASKS, NUM_SERVERS);
+                cache.store(key, results[cell]);
+            });
+        }
+        group.wait();
+    }
+    auto endTime = std::chrono::steady_clock::now();
+
+    std::vector<size_t> order(grid.size());
+    for (size_t cell = 0; cell < grid.size(); ++cell) {
+        order[cell] = cell;
+    }
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return results[a].makespanRatio < results[b].makespanRatio; });
+
+    std::cout << std::setw(28) << "Grid Cells" << std::setw(20) << grid.size() << std::endl;
+    std::cout << std::setw(28) << "Cached Cells" << std::setw(20) << cachedCells << std::endl;
+    std::cout << std::setw(28) << "Threads" << std::setw(20) << numThreads << std::endl;
+    std::cout << std::setw(28) << "Sweep Time (μs)" << std::setw(20)
+              << std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() << std::endl;
+    std::cout << std::endl;
+
+    std::cout << std::setw(8) << "alpha" << std::setw(8) << "beta" << std::setw(8) << "rho" << std::setw(8) << "Q"
+              << std::setw(12) << "Iterations" << std::setw(16) << "Makespan Ratio" << std::setw(24)
+              << "Execution Time (μs)" << std::endl;
+    for (int i = 0; i < std::min<int>(TOP_RESULTS, order.size()); ++i) {
+        const AntColonyParameters& parameters = grid[order[i]];
+        std::cout << std::setw(8) << parameters.alpha << std::setw(8) << parameters.beta << std::setw(8)
+                  << parameters.rho << std::setw(8) << parameters.Q << std::setw(12) << parameters.numIterations
+                  << std::setw(16) << results[order[i]].makespanRatio << std::setw(24) << results[order[i]].duration
+                  << std::endl;
+    }
+
+    std::cout << std::endl;
+    pool.printUtilization();
+
+    if (!tracePath.empty()) {
+        // Cost of recording one event on this thread: the best of several short batches, since on a
+        // machine with few cores the writer's formatting otherwise lands inside the measurement
+        const int NUM_BATCHES = 10;
+        const int BATCH_SIZE = 5000;
+        double overhead = INFINITY;
+        for (int batch = 0; batch < NUM_BATCHES; ++batch) {
+            auto probeStart = std::chrono::steady_clock::now();
+            for (int probe = 0; probe < BATCH_SIZE; ++probe) {
+                TRACE_SCOPE("trace.overhead");
+            }
+            auto probeEnd = std::chrono::steady_clock::now();
+            overhead = std::min(overhead, std::chrono::duration<double, std::nano>(probeEnd - probeStart).count() / BATCH_SIZE);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        tracing::Tracer::get().stop();
+
+        std::cout << std::endl;
+        std::cout << std::setw(28) << "Trace File" << std::setw(20) << tracePath << std::endl;
+        std::cout << std::setw(28) << "Trace Events" << std::setw(20) << tracing::Tracer::get().getNumEvents()
+                  << std::endl;
+        std::cout << std::setw(28) << "Dropped Events" << std::setw(20) << tracing::Tracer::get().getDropped()
+                  << std::endl;
+        std::cout << std::setw(28) << "Overhead (ns/event)" << std::setw(20) << std::setprecision(1)
+                  << overhead << std::endl;
+    }
+
+    return 0;
+}
@@ -4,7 +4,10 @@
 #include <cmath>
 #include <chrono>
 #include <iomanip>
+#include <string>
 #include <fmt/format.h>
+#include "profiling.h"
+#include "fast_range.h"
 
 // Server class
 class Server {
@@ -45,6 +48,7 @@ public:
 
     void run(const std::vector<double>& taskLoads) {
         LoadBalancingAlgorithm algorithm(servers);
+        PROFILE_ZONE("balanceLoad");
         algorithm.balanceLoad(taskLoads);
     }
 
@@ -66,12 +70,14 @@ public:
     RandomLoadBalancing(const std::vector<Server>& servers) : servers(servers) {}
 
     void balanceLoad(const std::vector<double>& taskLoads) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(0, servers.size() - 1);
+        fast_range::IndexStream indices(servers.size(), std::random_device{}());
 
         for (const auto& taskLoad : taskLoads) {
-            int randomServer = dis(gen);
+            int randomServer;
+            {
+                PROFILE_ZONE("random.rng");
+                randomServer = indices.next();
+            }
             servers[randomServer].addLoad(taskLoad);
         }
     }
@@ -83,18 +89,17 @@ private:
 // Round-Robin algorithm
 class RoundRobinLoadBalancing {
 public:
-    RoundRobinLoadBalancing(const std::vector<Server>& servers) : servers(servers), currentServer(0) {}
+    RoundRobinLoadBalancing(const std::vector<Server>& servers) : servers(servers), cursor(servers.size()) {}
 
     void balanceLoad(const std::vector<double>& taskLoads) {
         for (const auto& taskLoad : taskLoads) {
-            servers[currentServer].addLoad(taskLoad);
-            currentServer = (currentServer + 1) % servers.size();
+            servers[cursor.next()].addLoad(taskLoad);
         }
     }
 
 private:
     std::vector<Server> servers;
-    int currentServer;
+    fast_range::RoundRobinCursor cursor;
 };
 
 // Weighted Round-Robin algorithm
@@ -114,6 +119,8 @@ private:
     int currentServer;
 
     void updateCurrentServer() {
+        PROFILE_ZONE("weightedRoundRobin.select");
+        PROFILE_COUNT("weightedRoundRobin.serversScanned", servers.size());
         double minLoad = servers[0].getLoad();
         int minLoadServer = servers[0].getId();
         for (const auto& server : servers) {
@@ -136,10 +143,14 @@ public:
             // Find the server with the minimum load
             double minLoad = servers[0].getLoad();
             int minLoadServer = servers[0].getId();
-            for (const auto& server : servers) {
-                if (server.getLoad() < minLoad) {
-                    minLoad = server.getLoad();
-                    minLoadServer = server.getId();
+            {
+                PROFILE_ZONE("activeClustering.select");
+                PROFILE_COUNT("activeClustering.serversScanned", servers.size());
+                for (const auto& server : servers) {
+                    if (server.getLoad() < minLoad) {
+                        minLoad = server.getLoad();
+                        minLoadServer = server.getId();
+                    }
                 }
             }
 
@@ -152,37 +163,47 @@ private:
     std::vector<Server> servers;
 };
 
+// Ant Colony Optimization parameters. This benchmark times a single iteration by default.
+struct AntColonyParameters {
+    double alpha = 1.0;      // Pheromone importance factor
+    double beta = 2.0;       // Heuristic information importance factor
+    double rho = 0.5;        // Pheromone evaporation rate
+    double Q = 1.0;          // Pheromone deposit quantity
+    int numIterations = 1;
+};
+
 // Ant Colony Optimization algorithm
 class AntColonyOptimizationLoadBalancing {
 public:
-    AntColonyOptimizationLoadBalancing(const std::vector<Server>& servers) : servers(servers) {}
+    AntColonyOptimizationLoadBalancing(const std::vector<Server>& servers, AntColonyParameters parameters = {})
+        : servers(servers), parameters(parameters), gen(std::random_device{}()) {}
 
     void balanceLoad(const std::vector<double>& taskLoads) {
         int numTasks = taskLoads.size();
         int numServers = servers.size();
 
         // Ant Colony Optimization parameters
-        const double alpha = 1.0; // Pheromone importance factor
-        const double beta = 2.0;  // Heuristic information importance factor
-        const double rho = 0.5;   // Pheromone evaporation rate
-        const double Q = 1.0;     // Pheromone deposit quantity
+        const double alpha = parameters.alpha;
+        const double beta = parameters.beta;
+        const double rho = parameters.rho;
+        const double Q = parameters.Q;
 
         // Initialize pheromone trails
         std::vector<std::vector<double>> pheromones(numTasks, std::vector<double>(numServers, 1.0));
 
         // Perform Ant Colony Optimization
-        const int numIterations = 1;
-        for (int iteration = 0; iteration < numIterations; ++iteration) {
+        for (int iteration = 0; iteration < parameters.numIterations; ++iteration) {
             // Move ants
-//            for (int taskId = 0; taskId < numTasks; ++taskId) {
-//                int currentServer = selectNextServer(taskId, pheromones, taskLoads, alpha, beta);
-//                servers[currentServer].addLoad(taskLoads[taskId]);
-//            }
+            for (int taskId = 0; taskId < numTasks; ++taskId) {
+                int currentServer = selectNextServer(taskId, pheromones, taskLoads, alpha, beta);
+                servers[currentServer].addLoad(taskLoads[taskId]);
+            }
 
             // Update pheromones
             updatePheromones(pheromones, taskLoads, rho, Q);
 
             // Reset server loads
+            PROFILE_ZONE("antColony.resetLoads");
             for (auto& server : servers) {
                 server.resetLoad();
             }
@@ -191,10 +212,14 @@ public:
 
 private:
     std::vector<Server> servers;
+    AntColonyParameters parameters;
+    std::mt19937 gen;
 
     int selectNextServer(int taskId, const std::vector<std::vector<double>>& pheromones,
                          const std::vector<double>& taskLoads, double alpha, double beta) {
+        PROFILE_ZONE("antColony.selectNextServer");
         int numServers = servers.size();
+        PROFILE_COUNT("antColony.probabilitiesComputed", numServers);
 
         // Calculate selection probabilities
         std::vector<double> probabilities(numServers, 0.0);
@@ -207,17 +232,21 @@ private:
         }
 
         // Roulette wheel selection
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::uniform_real_distribution<> dis(0.0, totalProbability);
-        double selection = dis(gen);
+        double selection;
+        {
+            PROFILE_ZONE("antColony.rng");
+            selection = dis(gen);
+        }
         double cumulativeProbability = 0.0;
         for (int serverId = 0; serverId < numServers; ++serverId) {
             cumulativeProbability += probabilities[serverId];
             if (cumulativeProbability >= selection) {
+                PROFILE_COUNT("antColony.serversScanned", serverId + 1);
                 return serverId;
             }
         }
+        PROFILE_COUNT("antColony.serversScanned", numServers);
 
         // If no server is selected, return the last server
         return numServers - 1;
@@ -225,8 +254,10 @@ private:
 
     void updatePheromones(std::vector<std::vector<double>>& pheromones,
                           const std::vector<double>& taskLoads, double rho, double Q) {
+        PROFILE_ZONE("antColony.updatePheromones");
         int numTasks = taskLoads.size();
         int numServers = servers.size();
+        PROFILE_COUNT("antColony.pheromonesUpdated", numTasks * numServers);
 
         // Evaporate pheromones
         for (int taskId = 0; taskId < numTasks; ++taskId) {
@@ -289,6 +320,7 @@ int main() {
 
     for (size_t i = 0; i < numTasks.size(); ++i) {
         std::vector<double>taskLoads = generateRandomTaskLoads(numTasks[i]);
+        PROFILE_RESET();
 
         LoadBalancer<RandomLoadBalancing> randomBalancer(NUM_SERVERS);
         auto startTime = std::chrono::steady_clock::now();
@@ -324,6 +356,9 @@ int main() {
         endTime = std::chrono::steady_clock::now();
         auto antColonyOptimizationDuration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
         durations[4][i] = antColonyOptimizationDuration;
+
+        // Profiled builds print every algorithm's zones and counters for this task count
+        PROFILE_REPORT("Num Tasks: " + std::to_string(numTasks[i]));
     }
 
     printTable(durations, numTasks);
@@ -0,0 +1,452 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <fmt/format.h>
+
+// Server class
+class Server {
+public:
+    Server(int id, int capability) : id(id), capability(capability), load(0) {}
+
+    void addLoad(double taskLoad) {
+        load += taskLoad;
+    }
+
+    void resetLoad() {
+        load = 0;
+    }
+
+    double getLoad() const {
+        return load;
+    }
+
+    int getId() const {
+        return id;
+    }
+
+    int getCapability() const {
+        return capability;
+    }
+
+private:
+    int id;
+    int capability;
+    double load;
+};
+
+// Ant Colony Optimization parameters
+struct AntColonyParameters {
+    double alpha = 1.0;      // Pheromone importance factor
+    double beta = 2.0;       // Heuristic information importance factor
+    double rho = 0.5;        // Pheromone evaporation rate
+    double Q = 1.0;          // Pheromone deposit quantity
+    int numIterations = 100;
+};
+
+// Time spent walking ants and the number of ant-steps (one ant placing one task) taken
+struct AntStepStats {
+    double walkTime = 0; // Seconds
+    long long antSteps = 0;
+};
+
+// Ant Colony Optimization algorithm with a colony of numAnts ants per iteration, each walked on its
+// own by the scalar selectNextServer. The best ant of an iteration deposits pheromone, and the best
+// assignment over all iterations is committed.
+class AntColonyOptimizationLoadBalancing {
+public:
+    AntColonyOptimizationLoadBalancing(std::vector<Server>& servers, AntColonyParameters parameters, int numAnts,
+                                       uint64_t seed)
+        : servers(servers), parameters(parameters), numAnts(numAnts), gen(seed) {}
+
+    void balanceLoad(const std::vector<double>& taskLoads) {
+        int numTasks = taskLoads.size();
+        int numServers = servers.size();
+
+        // Initialize pheromone trails
+        std::vector<std::vector<double>> pheromones(numTasks, std::vector<double>(numServers, 1.0));
+
+        std::vector<std::vector<int>> assignments(numAnts, std::vector<int>(numTasks));
+        std::vector<std::vector<double>> loads(numAnts, std::vector<double>(numServers));
+        std::vector<int> bestAssignment(numTasks);
+        double bestMaxLoad = INFINITY;
+
+        for (int iteration = 0; iteration < parameters.numIterations; ++iteration) {
+            // Move ants
+            auto startTime = std::chrono::steady_clock::now();
+            for (int ant = 0; ant < numAnts; ++ant) {
+                std::fill(loads[ant].begin(), loads[ant].end(), 0.0);
+                for (int taskId = 0; taskId < numTasks; ++taskId) {
+                    int currentServer = selectNextServer(taskId, pheromones, loads[ant], taskLoads);
+                    loads[ant][currentServer] += taskLoads[taskId] / servers[currentServer].getCapability();
+                    assignments[ant][taskId] = currentServer;
+                }
+            }
+            auto endTime = std::chrono::steady_clock::now();
+            stats.walkTime += std::chrono::duration<double>(endTime - startTime).count();
+            stats.antSteps += (long long)numAnts * numTasks;
+
+            int iterationBest = 0;
+            double iterationBestMaxLoad = INFINITY;
+            for (int ant = 0; ant < numAnts; ++ant) {
+                double maxLoad = *std::max_element(loads[ant].begin(), loads[ant].end());
+                if (maxLoad < iterationBestMaxLoad) {
+                    iterationBestMaxLoad = maxLoad;
+                    iterationBest = ant;
+                }
+            }
+            if (iterationBestMaxLoad < bestMaxLoad) {
+                bestMaxLoad = iterationBestMaxLoad;
+                bestAssignment = assignments[iterationBest];
+            }
+
+            // Update pheromones
+            updatePheromones(pheromones, loads[iterationBest], taskLoads);
+        }
+
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            servers[bestAssignment[taskId]].addLoad(taskLoads[taskId]);
+        }
+    }
+
+    const AntStepStats& getStats() const {
+        return stats;
+    }
+
+private:
+    std::vector<Server>& servers;
+    AntColonyParameters parameters;
+    int numAnts;
+    std::mt19937_64 gen;
+    AntStepStats stats;
+
+    int selectNextServer(int taskId, const std::vector<std::vector<double>>& pheromones, const std::vector<double>& loads,
+                         const std::vector<double>& taskLoads) {
+        int numServers = servers.size();
+
+        // Calculate selection probabilities
+        std::vector<double> probabilities(numServers, 0.0);
+        double totalProbability = 0.0;
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            double pheromone = pheromones[taskId][serverId];
+            double taskTime = taskLoads[taskId] / servers[serverId].getCapability();
+            double heuristic = 1.0 / (std::pow(loads[serverId] + taskTime, parameters.beta));
+            probabilities[serverId] = std::pow(pheromone, parameters.alpha) * heuristic;
+            totalProbability += probabilities[serverId];
+        }
+
+        // Roulette wheel selection
+        std::uniform_real_distribution<> dis(0.0, totalProbability);
+        double selection = dis(gen);
+        double cumulativeProbability = 0.0;
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            cumulativeProbability += probabilities[serverId];
+            if (cumulativeProbability >= selection) {
+                return serverId;
+            }
+        }
+
+        // If no server is selected, return the last server
+        return numServers - 1;
+    }
+
+    void updatePheromones(std::vector<std::vector<double>>& pheromones, const std::vector<double>& loads,
+                          const std::vector<double>& taskLoads) {
+        int numTasks = taskLoads.size();
+        int numServers = servers.size();
+
+        // Evaporate pheromones
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            for (int serverId = 0; serverId < numServers; ++serverId) {
+                pheromones[taskId][serverId] *= (1.0 - parameters.rho);
+            }
+        }
+
+        // Deposit pheromones based on server loads
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            for (int serverId = 0; serverId < numServers; ++serverId) {
+                double taskTime = taskLoads[taskId] / servers[serverId].getCapability();
+                double deltaPheromone = parameters.Q / (loads[serverId] + taskTime);
+                pheromones[taskId][serverId] += deltaPheromone;
+            }
+        }
+    }
+};
+
+// SIMD vector types holding one value per ant. Vectors are passed by reference only, so the kernel
+// does not depend on the vector calling convention of the target.
+template <int Lanes>
+struct LaneTypes;
+
+template <>
+struct LaneTypes<8> {
+    typedef double Lane __attribute__((vector_size(8 * sizeof(double))));
+    typedef long long LaneMask __attribute__((vector_size(8 * sizeof(long long))));
+};
+
+template <>
+struct LaneTypes<16> {
+    typedef double Lane __attribute__((vector_size(16 * sizeof(double))));
+    typedef long long LaneMask __attribute__((vector_size(16 * sizeof(long long))));
+};
+
+// Ant Colony Optimization algorithm that walks Lanes ants at once, one ant per SIMD lane. Per-ant
+// state is stored lane-major (loads[serverId] holds that server's load for every ant), so a single
+// pass over a task's pheromone row loads each pheromone once, raises it to alpha once for the whole
+// colony and computes the weights of all ants with vector arithmetic. The roulette is vectorized
+// the same way: every lane draws its own threshold, and one pass over the cumulative weights
+// records, per lane, the first server that reaches it. The colony semantics match
+// AntColonyOptimizationLoadBalancing with numAnts = Lanes.
+template <int Lanes>
+class BatchedAntColonyOptimizationLoadBalancing {
+public:
+    typedef typename LaneTypes<Lanes>::Lane Lane;
+    typedef typename LaneTypes<Lanes>::LaneMask LaneMask;
+
+    BatchedAntColonyOptimizationLoadBalancing(std::vector<Server>& servers, AntColonyParameters parameters,
+                                              uint64_t seed)
+        : servers(servers), parameters(parameters), gen(seed) {
+        // Integral beta (the common case) is evaluated with vector multiplies instead of per-lane pow
+        integralBeta = parameters.beta == std::floor(parameters.beta) && parameters.beta >= 1 && parameters.beta <= 8
+                           ? int(parameters.beta)
+                           : 0;
+    }
+
+    void balanceLoad(const std::vector<double>& taskLoads) {
+        int numTasks = taskLoads.size();
+        int numServers = servers.size();
+
+        // Initialize pheromone trails
+        std::vector<std::vector<double>> pheromones(numTasks, std::vector<double>(numServers, 1.0));
+
+        std::vector<double> inverseCapabilities(numServers);
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            inverseCapabilities[serverId] = 1.0 / servers[serverId].getCapability();
+        }
+
+        std::vector<Lane> loads(numServers);
+        std::vector<Lane> weights(numServers);
+        std::vector<LaneMask> assignments(numTasks);
+        std::vector<int> bestAssignment(numTasks);
+        std::vector<double> bestLoads(numServers);
+        double bestMaxLoad = INFINITY;
+
+        for (int iteration = 0; iteration < parameters.numIterations; ++iteration) {
+            // Move ants
+            auto startTime = std::chrono::steady_clock::now();
+            std::fill(loads.begin(), loads.end(), Lane{});
+            for (int taskId = 0; taskId < numTasks; ++taskId) {
+                LaneMask& selected = assignments[taskId];
+                selectNextServers(pheromones[taskId], taskLoads[taskId], inverseCapabilities, loads, weights, selected);
+                for (int lane = 0; lane < Lanes; ++lane) {
+                    int serverId = selected[lane];
+                    loads[serverId][lane] += taskLoads[taskId] * inverseCapabilities[serverId];
+                }
+            }
+            auto endTime = std::chrono::steady_clock::now();
+            stats.walkTime += std::chrono::duration<double>(endTime - startTime).count();
+            stats.antSteps += (long long)Lanes * numTasks;
+
+            Lane maxLoads = loads[0];
+            for (int serverId = 1; serverId < numServers; ++serverId) {
+                maxLoads = maxLoads < loads[serverId] ? loads[serverId] : maxLoads;
+            }
+            int iterationBest = 0;
+            for (int lane = 1; lane < Lanes; ++lane) {
+                if (maxLoads[lane] < maxLoads[iterationBest]) {
+                    iterationBest = lane;
+                }
+            }
+            if (maxLoads[iterationBest] < bestMaxLoad) {
+                bestMaxLoad = maxLoads[iterationBest];
+                for (int taskId = 0; taskId < numTasks; ++taskId) {
+                    bestAssignment[taskId] = assignments[taskId][iterationBest];
+                }
+            }
+
+            // Update pheromones
+            for (int serverId = 0; serverId < numServers; ++serverId) {
+                bestLoads[serverId] = loads[serverId][iterationBest];
+            }
+            updatePheromones(pheromones, bestLoads, taskLoads, inverseCapabilities);
+        }
+
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            servers[bestAssignment[taskId]].addLoad(taskLoads[taskId]);
+        }
+    }
+
+    const AntStepStats& getStats() const {
+        return stats;
+    }
+
+private:
+    std::vector<Server>& servers;
+    AntColonyParameters parameters;
+    std::mt19937_64 gen;
+    int integralBeta;
+    AntStepStats stats;
+
+    // Heuristic 1 / distance^beta for every lane
+    void heuristic(const Lane& distance, Lane& result) const {
+        if (integralBeta) {
+            Lane power = distance;
+            for (int i = 1; i < integralBeta; ++i) {
+                power *= distance;
+            }
+            result = 1.0 / power;
+            return;
+        }
+        for (int lane = 0; lane < Lanes; ++lane) {
+            result[lane] = std::pow(distance[lane], -parameters.beta);
+        }
+    }
+
+    // Selects the next server of every ant for one task, stored per lane in selected
+    void selectNextServers(const std::vector<double>& pheromoneRow, double taskLoad,
+                           const std::vector<double>& inverseCapabilities, const std::vector<Lane>& loads,
+                           std::vector<Lane>& weights, LaneMask& selected) {
+        int numServers = loads.size();
+
+        // Calculate selection weights of all ants in one pass over the pheromone row
+        Lane totals = {};
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            double trail = parameters.alpha == 1.0 ? pheromoneRow[serverId]
+                                                   : std::pow(pheromoneRow[serverId], parameters.alpha);
+            double taskTime = taskLoad * inverseCapabilities[serverId];
+            heuristic(loads[serverId] + taskTime, weights[serverId]);
+            weights[serverId] *= trail;
+            totals += weights[serverId];
+        }
+
+        // Roulette wheel selection in every lane
+        std::uniform_real_distribution<> dis(0.0, 1.0);
+        Lane selections;
+        for (int lane = 0; lane < Lanes; ++lane) {
+            selections[lane] = dis(gen);
+        }
+        selections *= totals;
+
+        // Lanes that never reach their threshold through rounding keep the last server
+        selected = LaneMask{} + (numServers - 1);
+        LaneMask pending = LaneMask{} - 1;
+        Lane cumulative = {};
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            cumulative += weights[serverId];
+            LaneMask reached = (cumulative >= selections) & pending;
+            selected = (selected & ~reached) | (reached & serverId);
+            pending &= ~reached;
+            // Stop once every lane has chosen; checked every few servers to keep the loop branch-light
+            if ((serverId & 7) == 7) {
+                bool anyPending = false;
+                for (int lane = 0; lane < Lanes; ++lane) {
+                    anyPending |= pending[lane] != 0;
+                }
+                if (!anyPending) {
+                    break;
+                }
+            }
+        }
+    }
+
+    void updatePheromones(std::vector<std::vector<double>>& pheromones, const std::vector<double>& loads,
+                          const std::vector<double>& taskLoads, const std::vector<double>& inverseCapabilities) {
+        int numTasks = taskLoads.size();
+        int numServers = servers.size();
+
+        // Evaporate pheromones and deposit based on server loads
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            for (int serverId = 0; serverId < numServers; ++serverId) {
+                double taskTime = taskLoads[taskId] * inverseCapabilities[serverId];
+                pheromones[taskId][serverId] =
+                    pheromones[taskId][serverId] * (1.0 - parameters.rho) + parameters.Q / (loads[serverId] + taskTime);
+            }
+        }
+    }
+};
+
+// Helper function to generate the workload of one seed: task loads and server capabilities
+void generateWorkload(uint64_t seed, int numTasks, int numServers, std::vector<double>& taskLoads,
+                      std::vector<int>& capabilities) {
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<> loadDis(1.0, 10.0);
+    std::uniform_int_distribution<> capabilityDis(1, 100);
+    taskLoads.resize(numTasks);
+    for (int i = 0; i < numTasks; ++i) {
+        taskLoads[i] = loadDis(gen);
+    }
+    capabilities.resize(numServers);
+    for (int i = 0; i < numServers; ++i) {
+        capabilities[i] = capabilityDis(gen);
+    }
+}
+
+// Helper function to run one colony and report its ant-step throughput relative to the scalar
+// baseline and its makespan ratio; returns the throughput in ant-steps per second
+template <typename LoadBalancingAlgorithm, typename... Args>
+double measure(const std::string& name, int numAnts, const std::vector<double>& taskLoads,
+               const std::vector<int>& capabilities, double scalarRate, Args... args) {
+    std::vector<Server> servers;
+    for (int i = 0; i < int(capabilities.size()); ++i) {
+        servers.push_back(Server(i, capabilities[i]));
+    }
+    LoadBalancingAlgorithm algorithm(servers, args...);
+    algorithm.balanceLoad(taskLoads);
+
+    double totalLoad = 0.0;
+    double totalCapability = 0.0;
+    double makespan = 0.0;
+    for (const auto& server : servers) {
+        totalLoad += server.getLoad();
+        totalCapability += server.getCapability();
+        makespan = std::max(makespan, server.getLoad() / server.getCapability());
+    }
+
+    double rate = algorithm.getStats().antSteps / algorithm.getStats().walkTime;
+    std::cout << std::setw(28) << name << std::setw(8) << numAnts << std::setw(20) << std::setprecision(3)
+              << rate / 1e6 << std::setw(12) << std::setprecision(2) << rate / (scalarRate > 0 ? scalarRate : rate)
+              << std::setw(16) << std::setprecision(3) << makespan / (totalLoad / totalCapability) << std::endl;
+    return rate;
+}
+
+int main() {
+    const int NUM_TASKS = 500;
+    const int NUM_SERVERS = 64;
+    const int NUM_ITERATIONS = 20;
+    const uint64_t SEED = 42;
+
+    std::vector<double> taskLoads;
+    std::vector<int> capabilities;
+    generateWorkload(SEED, NUM_TASKS, NUM_SERVERS, taskLoads, capabilities);
+
+    AntColonyParameters parameters;
+    parameters.numIterations = NUM_ITERATIONS;
+
+    std::cout << std::setw(28) << "Ant Colony Kernel" << std::setw(8) << "Ants" << std::setw(20)
+              << "M Ant-Steps/s" << std::setw(12) << "Speedup" << std::setw(16) << "Makespan Ratio" << std::endl;
+    std::cout << std::fixed;
+
+    // Scalar throughput per ant-step does not depend on the colony size, so the 8-ant run is the baseline
+    double scalarRate = measure<AntColonyOptimizationLoadBalancing>("Scalar selectNextServer", 8, taskLoads,
+                                                                    capabilities, 0.0, parameters, 8, SEED);
+    measure<AntColonyOptimizationLoadBalancing>("Scalar selectNextServer", 16, taskLoads, capabilities, scalarRate,
+                                                parameters, 16, SEED);
+    measure<BatchedAntColonyOptimizationLoadBalancing<8>>("Batched Lanes", 8, taskLoads, capabilities, scalarRate,
+                                                          parameters, SEED);
+    measure<BatchedAntColonyOptimizationLoadBalancing<16>>("Batched Lanes", 16, taskLoads, capabilities, scalarRate,
+                                                           parameters, SEED);
+
+    // Non-integral beta falls back to per-lane pow for the heuristic
+    parameters.beta = 1.5;
+    std::cout << std::endl << "beta = " << parameters.beta << std::endl;
+    scalarRate = measure<AntColonyOptimizationLoadBalancing>("Scalar selectNextServer", 8, taskLoads, capabilities,
+                                                             0.0, parameters, 8, SEED);
+    measure<BatchedAntColonyOptimizationLoadBalancing<8>>("Batched Lanes", 8, taskLoads, capabilities, scalarRate,
+                                                          parameters, SEED);
+
+    return 0;
+}
@@ -0,0 +1,486 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+#include <fmt/format.h>
+
+// Server class: c parallel service slots of equal speed in front of a FIFO queue
+class Server {
+public:
+    struct QueuedTask {
+        double arrivalTime;
+        double taskLoad;
+    };
+
+    Server(int id, int slots, double slotSpeed) : id(id), slots(slots), busySlots(0), slotSpeed(slotSpeed) {}
+
+    // Returns true when a slot is free and the task starts service immediately
+    bool addLoad(double time, double taskLoad) {
+        if (busySlots < slots) {
+            ++busySlots;
+            return true;
+        }
+        loads.push_back({time, taskLoad});
+        return false;
+    }
+
+    // Frees a slot; returns true and the next task when a waiting task takes it over
+    bool completeTask(QueuedTask& next) {
+        --busySlots;
+        if (loads.empty() || busySlots >= slots) {
+            return false;
+        }
+        next = loads.front();
+        loads.pop_front();
+        ++busySlots;
+        return true;
+    }
+
+    // Tasks in the system, in service or waiting
+    int getLoad() const {
+        return busySlots + int(std::ssize(loads));
+    }
+
+    int getId() const {
+        return id;
+    }
+
+    int getSlots() const {
+        return slots;
+    }
+
+    // Tasks already in service keep running; only new starts see the new slot count
+    void setSlots(int newSlots) {
+        slots = newSlots;
+    }
+
+    double getServiceTime(double taskLoad) const {
+        return taskLoad / slotSpeed;
+    }
+
+    void save(std::ostream& out) const;
+    static Server load(std::istream& in);
+
+private:
+    int id;
+    int slots;
+    int busySlots;
+    double slotSpeed;
+    std::deque<QueuedTask> loads;
+};
+
+// Simulation events, kept in a binary min-heap on time
+struct Event {
+    enum Type : int32_t {
+        Arrival,
+        Departure
+    };
+
+    double time;
+    Type type;
+    int32_t serverId;
+    double arrivalTime;
+
+    bool operator>(const Event& other) const {
+        return time > other.time;
+    }
+};
+
+// Metrics collected by the simulation
+struct Metrics {
+    long long arrivals = 0;
+    long long completed = 0;
+    double totalResponseTime = 0;
+    int maxLoad = 0;
+
+    bool operator==(const Metrics& other) const = default;
+};
+
+// Helper functions for the binary snapshot format
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readValue(std::istream& in) {
+    T value;
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw std::runtime_error("truncated checkpoint");
+    }
+    return value;
+}
+
+void Server::save(std::ostream& out) const {
+    writeValue(out, int32_t(id));
+    writeValue(out, int32_t(slots));
+    writeValue(out, int32_t(busySlots));
+    writeValue(out, slotSpeed);
+    writeValue(out, uint64_t(loads.size()));
+    for (const auto& task : loads) {
+        writeValue(out, task);
+    }
+}
+
+Server Server::load(std::istream& in) {
+    int id = readValue<int32_t>(in);
+    int slots = readValue<int32_t>(in);
+    int busySlots = readValue<int32_t>(in);
+    double slotSpeed = readValue<double>(in);
+    Server server(id, slots, slotSpeed);
+    server.busySlots = busySlots;
+    uint64_t numWaiting = readValue<uint64_t>(in);
+    for (uint64_t i = 0; i < numWaiting; ++i) {
+        server.loads.push_back(readValue<QueuedTask>(in));
+    }
+    return server;
+}
+
+// Simulation state: everything needed to continue a run. Servers are shared between forks and
+// copied on first write, so forking a warm state costs one pointer per server and each branch
+// only pays for the servers it actually touches.
+class SimulationState {
+public:
+    SimulationState(const std::vector<int>& capabilities, double slotSpeed, double arrivalRate, uint64_t seed)
+        : time(0), arrivalRate(arrivalRate), gen(seed), copiedServers(0) {
+        int numServers = capabilities.size();
+        for (int i = 0; i < numServers; ++i) {
+            servers.push_back(std::make_shared<Server>(i, capabilities[i], slotSpeed));
+        }
+        pushEvent({nextArrivalTime(), Event::Arrival, -1, 0});
+    }
+
+    // In-process fork: shares every server with this state until one side modifies it
+    SimulationState fork() const {
+        SimulationState branch = *this;
+        branch.copiedServers = 0;
+        return branch;
+    }
+
+    const Server& server(int serverId) const {
+        return *servers[serverId];
+    }
+
+    Server& mutableServer(int serverId) {
+        auto& server = servers[serverId];
+        if (server.use_count() > 1) {
+            server = std::make_shared<Server>(*server);
+            ++copiedServers;
+        }
+        return *server;
+    }
+
+    int getNumServers() const {
+        return servers.size();
+    }
+
+    void pushEvent(const Event& event) {
+        events.push_back(event);
+        std::push_heap(events.begin(), events.end(), std::greater<>());
+    }
+
+    Event popEvent() {
+        std::pop_heap(events.begin(), events.end(), std::greater<>());
+        Event event = events.back();
+        events.pop_back();
+        return event;
+    }
+
+    double nextEventTime() const {
+        return events.front().time;
+    }
+
+    double nextArrivalTime() {
+        return time + std::exponential_distribution<>(arrivalRate)(gen);
+    }
+
+    double nextTaskLoad() {
+        return std::uniform_real_distribution<>(1.0, 10.0)(gen);
+    }
+
+    // Compact binary snapshot: header, clock, RNG state, event heap, servers and metrics
+    void save(std::ostream& out) const {
+        out.write("LBCK", 4);
+        writeValue(out, uint32_t(1));
+        writeValue(out, time);
+        writeValue(out, arrivalRate);
+
+        std::ostringstream rngState;
+        rngState << gen;
+        writeValue(out, uint64_t(rngState.str().size()));
+        out.write(rngState.str().data(), rngState.str().size());
+
+        writeValue(out, uint64_t(events.size()));
+        out.write(reinterpret_cast<const char*>(events.data()), events.size() * sizeof(Event));
+
+        writeValue(out, uint64_t(servers.size()));
+        for (const auto& server : servers) {
+            server->save(out);
+        }
+        writeValue(out, metrics);
+    }
+
+    static SimulationState load(std::istream& in) {
+        char magic[4];
+        if (!in.read(magic, 4) || std::string(magic, 4) != "LBCK" || readValue<uint32_t>(in) != 1) {
+            throw std::runtime_error("not a checkpoint");
+        }
+        SimulationState state;
+        state.time = readValue<double>(in);
+        state.arrivalRate = readValue<double>(in);
+
+        std::string rngState(readValue<uint64_t>(in), '\0');
+        if (!in.read(rngState.data(), rngState.size()) || !(std::istringstream(rngState) >> state.gen)) {
+            throw std::runtime_error("truncated checkpoint");
+        }
+
+        state.events.resize(readValue<uint64_t>(in));
+        if (!in.read(reinterpret_cast<char*>(state.events.data()), state.events.size() * sizeof(Event))) {
+            throw std::runtime_error("truncated checkpoint");
+        }
+
+        uint64_t numServers = readValue<uint64_t>(in);
+        for (uint64_t i = 0; i < numServers; ++i) {
+            state.servers.push_back(std::make_shared<Server>(Server::load(in)));
+        }
+        state.metrics = readValue<Metrics>(in);
+        return state;
+    }
+
+    int getCopiedServers() const {
+        return copiedServers;
+    }
+
+    std::mt19937_64& getGenerator() {
+        return gen;
+    }
+
+    double time;
+    Metrics metrics;
+
+private:
+    SimulationState() : time(0), arrivalRate(0), copiedServers(0) {}
+
+    double arrivalRate;
+    std::mt19937_64 gen;
+    std::vector<Event> events;
+    std::vector<std::shared_ptr<Server>> servers;
+    int copiedServers;
+};
+
+// Discrete-event simulation driven by one load balancing algorithm
+template <typename LoadBalancingAlgorithm>
+class Simulation {
+public:
+    Simulation(SimulationState state) : state(std::move(state)) {}
+
+    void runUntil(double endTime) {
+        while (state.nextEventTime() <= endTime) {
+            Event event = state.popEvent();
+            state.time = event.time;
+            if (event.type == Event::Arrival) {
+                handleArrival();
+            } else {
+                handleDeparture(event);
+            }
+        }
+        state.time = endTime;
+    }
+
+    SimulationState& getState() {
+        return state;
+    }
+
+private:
+    SimulationState state;
+    LoadBalancingAlgorithm algorithm;
+
+    void handleArrival() {
+        double taskLoad = state.nextTaskLoad();
+        int serverId = algorithm.selectServer(state);
+        ++state.metrics.arrivals;
+
+        Server& server = state.mutableServer(serverId);
+        if (server.addLoad(state.time, taskLoad)) {
+            state.pushEvent({state.time + server.getServiceTime(taskLoad), Event::Departure, serverId, state.time});
+        }
+        state.metrics.maxLoad = std::max(state.metrics.maxLoad, server.getLoad());
+        state.pushEvent({state.nextArrivalTime(), Event::Arrival, -1, 0});
+    }
+
+    void handleDeparture(const Event& event) {
+        ++state.metrics.completed;
+        state.metrics.totalResponseTime += state.time - event.arrivalTime;
+
+        Server& server = state.mutableServer(event.serverId);
+        Server::QueuedTask next;
+        if (server.completeTask(next)) {
+            state.pushEvent({state.time + server.getServiceTime(next.taskLoad), Event::Departure, event.serverId,
+                             next.arrivalTime});
+        }
+    }
+};
+
+// Random algorithm
+class RandomLoadBalancing {
+public:
+    int selectServer(SimulationState& state) {
+        return std::uniform_int_distribution<>(0, state.getNumServers() - 1)(state.getGenerator());
+    }
+};
+
+// Round-Robin algorithm; the position is derived from the arrival count so it survives checkpoints
+class RoundRobinLoadBalancing {
+public:
+    int selectServer(SimulationState& state) {
+        return state.metrics.arrivals % state.getNumServers();
+    }
+};
+
+// Power-of-two-choices algorithm, comparing tasks per slot
+class PowerOfTwoChoicesLoadBalancing {
+public:
+    int selectServer(SimulationState& state) {
+        std::uniform_int_distribution<> dis(0, state.getNumServers() - 1);
+        int first = dis(state.getGenerator());
+        int second = dis(state.getGenerator());
+        return relativeLoad(state.server(second)) < relativeLoad(state.server(first)) ? second : first;
+    }
+
+private:
+    static double relativeLoad(const Server& server) {
+        return double(server.getLoad() + 1) / std::max(1, server.getSlots());
+    }
+};
+
+// Active Clustering algorithm (least tasks per slot)
+class ActiveClusteringLoadBalancing {
+public:
+    int selectServer(SimulationState& state) {
+        int minLoadServer = 0;
+        double minLoad = INFINITY;
+        for (int serverId = 0; serverId < state.getNumServers(); ++serverId) {
+            const Server& server = state.server(serverId);
+            double load = double(server.getLoad() + 1) / std::max(1, server.getSlots());
+            if (load < minLoad) {
+                minLoad = load;
+                minLoadServer = serverId;
+            }
+        }
+        return minLoadServer;
+    }
+};
+
+// Helper function to generate random capabilities for servers
+std::vector<int> generateRandomCapabilities(int numServers, int minCapability, int maxCapability) {
+    std::vector<int> capabilities(numServers);
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> dis(minCapability, maxCapability);
+    for (int i = 0; i < numServers; ++i) {
+        capabilities[i] = dis(gen);
+    }
+    return capabilities;
+}
+
+// Helper function to run one what-if branch: the incident halves the slots of the first
+// servers, keeping at least one so no queued task is stranded, then the branch continues with its
+// own algorithm
+template <typename LoadBalancingAlgorithm>
+void runBranch(const std::string& name, const SimulationState& warmState, int incidentServers, double endTime) {
+    auto startTime = std::chrono::steady_clock::now();
+    Simulation<LoadBalancingAlgorithm> branch(warmState.fork());
+    auto forkTime = std::chrono::steady_clock::now();
+
+    Metrics before = branch.getState().metrics;
+    for (int serverId = 0; serverId < incidentServers; ++serverId) {
+        Server& server = branch.getState().mutableServer(serverId);
+        server.setSlots(std::max(1, server.getSlots() / 2));
+    }
+    branch.runUntil(endTime);
+    auto endRunTime = std::chrono::steady_clock::now();
+
+    const Metrics& after = branch.getState().metrics;
+    double responseTime = (after.totalResponseTime - before.totalResponseTime) / (after.completed - before.completed);
+    std::cout << std::setw(24) << name << std::setw(16)
+              << std::chrono::duration_cast<std::chrono::microseconds>(forkTime - startTime).count() << std::setw(16)
+              << std::chrono::duration_cast<std::chrono::microseconds>(endRunTime - forkTime).count() << std::setw(16)
+              << branch.getState().getCopiedServers() << std::setw(20) << responseTime << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const int NUM_SERVERS = 1000;
+    const int MIN_CAPABILITY = 1;
+    const int MAX_CAPABILITY = 8;
+    const double SLOT_SPEED = 1.0;
+    const double MEAN_TASK_LOAD = 5.5;
+    const double OFFERED_LOAD = 0.8;
+    const double WARMUP_TIME = 500.0;
+    const double BRANCH_TIME = 100.0;
+    const int INCIDENT_SERVERS = NUM_SERVERS / 5;
+    std::string path = argc > 1 ? argv[1] : "checkpoint.bin";
+
+    std::vector<int> capabilities = generateRandomCapabilities(NUM_SERVERS, MIN_CAPABILITY, MAX_CAPABILITY);
+    double totalCapability = 0.0;
+    for (const auto& capability : capabilities) {
+        totalCapability += capability * SLOT_SPEED;
+    }
+    double arrivalRate = OFFERED_LOAD * totalCapability / MEAN_TASK_LOAD;
+
+    // Warm up once
+    auto startTime = std::chrono::steady_clock::now();
+    Simulation<PowerOfTwoChoicesLoadBalancing> warmup(
+        SimulationState(capabilities, SLOT_SPEED, arrivalRate, std::random_device{}()));
+    warmup.runUntil(WARMUP_TIME);
+    auto warmupTime = std::chrono::steady_clock::now();
+
+    // Checkpoint to disk and restore
+    {
+        std::ofstream out(path, std::ios::binary);
+        warmup.getState().save(out);
+    }
+    auto checkpointTime = std::chrono::steady_clock::now();
+    std::ifstream in(path, std::ios::binary);
+    Simulation<PowerOfTwoChoicesLoadBalancing> restored(SimulationState::load(in));
+    auto restoreTime = std::chrono::steady_clock::now();
+
+    // A restored run must continue exactly like the original
+    Simulation<PowerOfTwoChoicesLoadBalancing> original(warmup.getState().fork());
+    original.runUntil(WARMUP_TIME + BRANCH_TIME);
+    restored.runUntil(WARMUP_TIME + BRANCH_TIME);
+    bool identical = original.getState().metrics == restored.getState().metrics;
+
+    std::cout << std::setw(28) << "Warm-up Events" << std::setw(20)
+              << warmup.getState().metrics.arrivals + warmup.getState().metrics.completed << std::endl;
+    std::cout << std::setw(28) << "Warm-up (μs)" << std::setw(20)
+              << std::chrono::duration_cast<std::chrono::microseconds>(warmupTime - startTime).count() << std::endl;
+    std::cout << std::setw(28) << "Checkpoint (μs)" << std::setw(20)
+              << std::chrono::duration_cast<std::chrono::microseconds>(checkpointTime - warmupTime).count() << std::endl;
+    std::cout << std::setw(28) << "Restore (μs)" << std::setw(20)
+              << std::chrono::duration_cast<std::chrono::microseconds>(restoreTime - checkpointTime).count() << std::endl;
+    std::cout << std::setw(28) << "Checkpoint Size (bytes)" << std::setw(20) << in.tellg() << std::endl;
+    std::cout << std::setw(28) << "Restored Run Identical" << std::setw(20) << (identical ? "yes" : "no") << std::endl;
+    std::cout << std::endl;
+
+    // What-if branches: every algorithm reacts to the same incident from the same warm state
+    std::cout << std::setw(24) << "Branch Algorithm" << std::setw(16) << "Fork (μs)" << std::setw(16) << "Run (μs)"
+              << std::setw(16) << "Copied Servers" << std::setw(20) << "Mean Response Time" << std::endl;
+    runBranch<RandomLoadBalancing>("Random", warmup.getState(), INCIDENT_SERVERS, WARMUP_TIME + BRANCH_TIME);
+    runBranch<RoundRobinLoadBalancing>("Round-Robin", warmup.getState(), INCIDENT_SERVERS, WARMUP_TIME + BRANCH_TIME);
+    runBranch<PowerOfTwoChoicesLoadBalancing>("Power of Two Choices", warmup.getState(), INCIDENT_SERVERS,
+                                              WARMUP_TIME + BRANCH_TIME);
+    runBranch<ActiveClusteringLoadBalancing>("Active Clustering", warmup.getState(), INCIDENT_SERVERS,
+                                             WARMUP_TIME + BRANCH_TIME);
+
+    return 0;
+}
@@ -0,0 +1,519 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <coroutine>
+#include <exception>
+#include <stdexcept>
+#include <cstdint>
+#include <fmt/format.h>
+
+// Frame pool: coroutine frames are carved from large chunks and recycled through per-size free
+// lists, so spawning a process costs a pointer pop instead of a malloc and a million suspended
+// processes carry no per-allocation header. Sizes are rounded up to 16 bytes, which keeps every
+// block at the alignment operator new guarantees. The simulation is single-threaded, and so is
+// the pool.
+class FramePool {
+public:
+    static constexpr size_t GRANULARITY = 16;
+    static constexpr size_t NUM_CLASSES = 128; // Frames up to 2 KiB are pooled
+    static constexpr size_t CHUNK_SIZE = 1 << 20;
+
+    static FramePool& instance() {
+        static FramePool pool;
+        return pool;
+    }
+
+    void* allocate(size_t size) {
+        size_t sizeClass = (size + GRANULARITY - 1) / GRANULARITY;
+        if (sizeClass >= NUM_CLASSES) {
+            return ::operator new(size);
+        }
+        if (!enabled) {
+            ++heapFrames;
+            return ::operator new(size);
+        }
+        ++liveFrames;
+        peakFrames = std::max(peakFrames, liveFrames);
+        if (FreeBlock* block = freeLists[sizeClass]) {
+            freeLists[sizeClass] = block->next;
+            return block;
+        }
+        size_t bytes = sizeClass * GRANULARITY;
+        if (chunkRemaining < bytes) {
+            chunks.push_back(std::make_unique<char[]>(CHUNK_SIZE));
+            chunkCursor = chunks.back().get();
+            chunkRemaining = CHUNK_SIZE;
+        }
+        void* block = chunkCursor;
+        chunkCursor += bytes;
+        chunkRemaining -= bytes;
+        return block;
+    }
+
+    void deallocate(void* pointer, size_t size) {
+        size_t sizeClass = (size + GRANULARITY - 1) / GRANULARITY;
+        if (sizeClass >= NUM_CLASSES) {
+            ::operator delete(pointer);
+            return;
+        }
+        if (!enabled) {
+            --heapFrames;
+            ::operator delete(pointer);
+            return;
+        }
+        --liveFrames;
+        FreeBlock* block = static_cast<FreeBlock*>(pointer);
+        block->next = freeLists[sizeClass];
+        freeLists[sizeClass] = block;
+    }
+
+    // deallocate returns a frame the way the current setting would have allocated it, so the
+    // setting may only change while no poolable frame is alive
+    void setEnabled(bool value) {
+        if (liveFrames != 0 || heapFrames != 0) {
+            throw std::runtime_error("cannot switch the frame pool while frames are alive");
+        }
+        enabled = value;
+    }
+
+    size_t getPeakFrames() const {
+        return peakFrames;
+    }
+
+    size_t getReservedBytes() const {
+        return chunks.size() * CHUNK_SIZE;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    bool enabled = true;
+    FreeBlock* freeLists[NUM_CLASSES] = {};
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char* chunkCursor = nullptr;
+    size_t chunkRemaining = 0;
+    size_t liveFrames = 0;
+    size_t heapFrames = 0; // Poolable frames taken from operator new while the pool was disabled
+    size_t peakFrames = 0;
+};
+
+// Simulated process: a coroutine that starts suspended, is started by Simulation::spawn and
+// destroys its own frame when it returns
+class Process {
+public:
+    struct promise_type {
+        Process get_return_object() {
+            return Process(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() {
+            std::terminate();
+        }
+
+        static void* operator new(size_t size) {
+            return FramePool::instance().allocate(size);
+        }
+
+        static void operator delete(void* pointer, size_t size) {
+            FramePool::instance().deallocate(pointer, size);
+        }
+    };
+
+    std::coroutine_handle<> getHandle() const {
+        return handle;
+    }
+
+private:
+    explicit Process(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Discrete-event engine driving processes: every event resumes one suspended coroutine. Events
+// at equal times run in scheduling order.
+class Simulation {
+public:
+    struct Event {
+        double time;
+        uint64_t sequence;
+        std::coroutine_handle<> handle;
+
+        bool operator>(const Event& other) const {
+            return time != other.time ? time > other.time : sequence > other.sequence;
+        }
+    };
+
+    // Awaitable returned by delay()
+    struct DelayAwaiter {
+        Simulation& simulation;
+        double delay;
+
+        bool await_ready() const {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            simulation.schedule(simulation.now() + delay, handle);
+        }
+
+        void await_resume() {}
+    };
+
+    // Starts a process at the current time
+    void spawn(Process process) {
+        schedule(currentTime, process.getHandle());
+    }
+
+    DelayAwaiter delay(double delay) {
+        return {*this, delay};
+    }
+
+    void schedule(double time, std::coroutine_handle<> handle) {
+        events.push_back({time, nextSequence++, handle});
+        std::push_heap(events.begin(), events.end(), std::greater<>());
+    }
+
+    // Runs until no process is waiting on time or on another process
+    void run() {
+        while (!events.empty()) {
+            std::pop_heap(events.begin(), events.end(), std::greater<>());
+            Event event = events.back();
+            events.pop_back();
+            currentTime = event.time;
+            ++numResumes;
+            event.handle.resume();
+        }
+    }
+
+    double now() const {
+        return currentTime;
+    }
+
+    long long getNumResumes() const {
+        return numResumes;
+    }
+
+private:
+    std::vector<Event> events;
+    double currentTime = 0;
+    uint64_t nextSequence = 0;
+    long long numResumes = 0;
+};
+
+// FIFO queue between processes: put() never blocks, co_await get() suspends until an item arrives.
+// An item put while processes are waiting is handed to the oldest waiter directly.
+template <typename T>
+class Queue {
+public:
+    struct GetAwaiter {
+        Queue& queue;
+        std::coroutine_handle<> handle;
+        T item;
+
+        bool await_ready() const {
+            return !queue.items.empty();
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            this->handle = handle;
+            queue.waiters.push_back(this);
+        }
+
+        T await_resume() {
+            if (handle) {
+                return std::move(item);
+            }
+            T front = std::move(queue.items.front());
+            queue.items.pop_front();
+            return front;
+        }
+    };
+
+    Queue(Simulation& simulation) : simulation(simulation) {}
+
+    void put(T item) {
+        if (waiters.empty()) {
+            items.push_back(std::move(item));
+            return;
+        }
+        GetAwaiter* waiter = waiters.front();
+        waiters.pop_front();
+        waiter->item = std::move(item);
+        simulation.schedule(simulation.now(), waiter->handle);
+    }
+
+    GetAwaiter get() {
+        return {*this, nullptr, T()};
+    }
+
+    int size() const {
+        return items.size();
+    }
+
+private:
+    Simulation& simulation;
+    std::deque<T> items;
+    std::deque<GetAwaiter*> waiters;
+};
+
+// Resource with a fixed number of units: co_await acquire() suspends until a unit is free and
+// release() hands the unit to the oldest waiter, if any
+class Resource {
+public:
+    struct AcquireAwaiter {
+        Resource& resource;
+
+        bool await_ready() {
+            if (resource.available > 0) {
+                --resource.available;
+                return true;
+            }
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            resource.waiters.push_back(handle);
+        }
+
+        void await_resume() {}
+    };
+
+    Resource(Simulation& simulation, int capacity) : simulation(simulation), capacity(capacity), available(capacity) {}
+
+    AcquireAwaiter acquire() {
+        return {*this};
+    }
+
+    void release() {
+        if (waiters.empty()) {
+            ++available;
+            return;
+        }
+        std::coroutine_handle<> next = waiters.front();
+        waiters.pop_front();
+        simulation.schedule(simulation.now(), next);
+    }
+
+    // Units in use plus processes waiting for one
+    int getLoad() const {
+        return capacity - available + int(waiters.size());
+    }
+
+    int getCapacity() const {
+        return capacity;
+    }
+
+private:
+    Simulation& simulation;
+    int capacity;
+    int available;
+    std::deque<std::coroutine_handle<>> waiters;
+};
+
+// Server: a resource with one unit per slot, serving slowly until it has warmed up
+class Server {
+public:
+    Server(Simulation& simulation, int id, int slots, double slotSpeed, double warmUpTime, double coldSlowdown)
+        : id(id), slots(simulation, slots), slotSpeed(slotSpeed), coldSlowdown(coldSlowdown), warm(false) {
+        simulation.spawn(warmUp(simulation, warmUpTime));
+    }
+
+    Resource& getSlots() {
+        return slots;
+    }
+
+    double getServiceTime(double taskLoad) const {
+        return taskLoad / slotSpeed * (warm ? 1.0 : coldSlowdown);
+    }
+
+    int getId() const {
+        return id;
+    }
+
+private:
+    int id;
+    Resource slots;
+    double slotSpeed;
+    double coldSlowdown;
+    bool warm;
+
+    Process warmUp(Simulation& simulation, double warmUpTime) {
+        co_await simulation.delay(warmUpTime);
+        warm = true;
+    }
+};
+
+// Client behavior parameters
+struct ClientParameters {
+    int numRequests = 2;
+    double meanThinkTime = 100.0;
+    double meanTaskLoad = 1.0;
+    int retryThreshold = 8;      // A server with this many requests in it is treated as busy
+    int maxRetries = 3;
+    double backoffTime = 1.0;    // Doubles with every retry
+};
+
+// Completed request, reported by clients to the metrics collector
+struct Completion {
+    double responseTime = 0;
+    int retries = 0;
+};
+
+// Client process: thinks, picks the less loaded of two random servers, backs off exponentially
+// while both candidates are busy (up to maxRetries, then queues anyway), waits for a slot and is
+// served
+Process client(Simulation& simulation, std::vector<std::unique_ptr<Server>>& servers, Queue<Completion>& completions,
+               const ClientParameters& parameters, uint64_t seed) {
+    // Everything declared here lives in the frame; a small generator keeps a client around 200 bytes
+    std::minstd_rand gen(seed + 1);
+    std::exponential_distribution<> thinkDis(1.0 / parameters.meanThinkTime);
+    std::exponential_distribution<> loadDis(1.0 / parameters.meanTaskLoad);
+    std::uniform_int_distribution<> serverDis(0, servers.size() - 1);
+
+    for (int request = 0; request < parameters.numRequests; ++request) {
+        co_await simulation.delay(thinkDis(gen));
+        double startTime = simulation.now();
+
+        Server* server = nullptr;
+        int retries = 0;
+        while (true) {
+            Server* first = servers[serverDis(gen)].get();
+            Server* second = servers[serverDis(gen)].get();
+            server = second->getSlots().getLoad() < first->getSlots().getLoad() ? second : first;
+            if (server->getSlots().getLoad() < parameters.retryThreshold || retries == parameters.maxRetries) {
+                break;
+            }
+            co_await simulation.delay(parameters.backoffTime * (1 << retries));
+            ++retries;
+        }
+
+        co_await server->getSlots().acquire();
+        co_await simulation.delay(server->getServiceTime(loadDis(gen)));
+        server->getSlots().release();
+        completions.put({simulation.now() - startTime, retries});
+    }
+}
+
+// Metrics collector process: consumes one completion per request
+Process collector(Queue<Completion>& completions, long long numCompletions, double& totalResponseTime,
+                  double& maxResponseTime, long long& totalRetries) {
+    for (long long i = 0; i < numCompletions; ++i) {
+        Completion completion = co_await completions.get();
+        totalResponseTime += completion.responseTime;
+        maxResponseTime = std::max(maxResponseTime, completion.responseTime);
+        totalRetries += completion.retries;
+    }
+}
+
+// Process that finishes as soon as it is started, for measuring spawn cost
+Process emptyProcess(long long& counter) {
+    ++counter;
+    co_return;
+}
+
+// Helper function to measure the cost of spawning, running and destroying one process. Processes
+// are spawned in small batches so the event heap stays shallow and allocation dominates.
+double measureSpawnCost(int numProcesses) {
+    const int BATCH_SIZE = 64;
+    Simulation simulation;
+    long long counter = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < numProcesses; i += BATCH_SIZE) {
+        for (int j = 0; j < BATCH_SIZE; ++j) {
+            simulation.spawn(emptyProcess(counter));
+        }
+        simulation.run();
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(endTime - startTime).count() / counter;
+}
+
+// Helper function to run the client/server model once and print its results
+void runModel(const std::string& name, int numClients, int numServers, const ClientParameters& parameters) {
+    const int SLOTS = 4;
+    const double WARM_UP_TIME = 20.0;
+    const double COLD_SLOWDOWN = 3.0;
+
+    // Offered load: numClients / meanThinkTime requests per unit of time against numServers * SLOTS slots
+    double slotSpeed = numClients / parameters.meanThinkTime * parameters.meanTaskLoad / (0.8 * numServers * SLOTS);
+
+    Simulation simulation;
+    Queue<Completion> completions(simulation);
+    std::vector<std::unique_ptr<Server>> servers;
+    for (int i = 0; i < numServers; ++i) {
+        servers.push_back(std::make_unique<Server>(simulation, i, SLOTS, slotSpeed, WARM_UP_TIME, COLD_SLOWDOWN));
+    }
+
+    long long numCompletions = (long long)numClients * parameters.numRequests;
+    double totalResponseTime = 0.0;
+    double maxResponseTime = 0.0;
+    long long totalRetries = 0;
+    simulation.spawn(collector(completions, numCompletions, totalResponseTime, maxResponseTime, totalRetries));
+    for (int i = 0; i < numClients; ++i) {
+        simulation.spawn(client(simulation, servers, completions, parameters, i));
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    simulation.run();
+    auto endTime = std::chrono::steady_clock::now();
+    double duration = std::chrono::duration<double>(endTime - startTime).count();
+
+    std::cout << std::setw(24) << name << std::setw(12) << numClients << std::setw(14)
+              << simulation.getNumResumes() << std::setw(14) << std::setprecision(1)
+              << duration * 1e9 / simulation.getNumResumes() << std::setw(16) << std::setprecision(3)
+              << totalResponseTime / numCompletions << std::setw(14) << maxResponseTime << std::setw(12)
+              << std::setprecision(2) << double(totalRetries) / numCompletions << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int numClients = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    const int NUM_SERVERS = 1000;
+    ClientParameters parameters;
+
+    std::cout << std::setw(24) << "Frame Allocation" << std::setw(12) << "Clients" << std::setw(14) << "Resumes"
+              << std::setw(14) << "ns/Resume" << std::setw(16) << "Mean Response" << std::setw(14) << "Max Response"
+              << std::setw(12) << "Retries" << std::endl;
+    std::cout << std::fixed;
+
+    FramePool::instance().setEnabled(false);
+    runModel("operator new", numClients, NUM_SERVERS, parameters);
+    FramePool::instance().setEnabled(true);
+    runModel("Frame pool", numClients, NUM_SERVERS, parameters);
+
+    std::cout << std::endl;
+    FramePool::instance().setEnabled(false);
+    double newSpawnCost = measureSpawnCost(numClients);
+    FramePool::instance().setEnabled(true);
+    double poolSpawnCost = measureSpawnCost(numClients);
+    std::cout << std::setw(24) << "Spawn ns (operator new)" << std::setw(16) << std::setprecision(1) << newSpawnCost
+              << std::endl;
+    std::cout << std::setw(24) << "Spawn ns (frame pool)" << std::setw(16) << poolSpawnCost << std::endl;
+    std::cout << std::setw(24) << "Peak Live Frames" << std::setw(16) << FramePool::instance().getPeakFrames()
+              << std::endl;
+    std::cout << std::setw(24) << "Pool Reserved (MiB)" << std::setw(16) << std::setprecision(1)
+              << FramePool::instance().getReservedBytes() / double(1 << 20) << std::endl;
+    std::cout << std::setw(24) << "Bytes per Frame" << std::setw(16)
+              << double(FramePool::instance().getReservedBytes()) / FramePool::instance().getPeakFrames()
+              << std::endl;
+
+    return 0;
+}
@@ -3,7 +3,9 @@
 #include <random>
 #include <cmath>
 #include <iomanip>
+#include <string>
 #include <fmt/format.h>
+#include "profiling.h"
 
 // Server class
 class Server {
@@ -50,6 +52,7 @@ public:
 
     void run(const std::vector<double>& taskLoads) {
         LoadBalancingAlgorithm algorithm(servers);
+        PROFILE_ZONE("balanceLoad");
         algorithm.balanceLoad(taskLoads);
     }
 
@@ -85,7 +88,11 @@ public:
         std::uniform_int_distribution<> dis(0, servers.size() - 1);
 
         for (const auto& taskLoad : taskLoads) {
-            int randomServer = dis(gen);
+            int randomServer;
+            {
+                PROFILE_ZONE("random.rng");
+                randomServer = dis(gen);
+            }
             servers[randomServer].addLoad(taskLoad);
         }
     }
@@ -128,6 +135,8 @@ private:
     int currentServer;
 
     void updateCurrentServer() {
+        PROFILE_ZONE("weightedRoundRobin.select");
+        PROFILE_COUNT("weightedRoundRobin.serversScanned", servers.size());
         double minLoad = servers[0].getLoad();
         int minLoadServer = servers[0].getId();
         for (const auto& server : servers) {
@@ -150,10 +159,14 @@ public:
             // Find the server with the minimum load
             double minLoad = servers[0].getLoad();
             int minLoadServer = servers[0].getId();
-            for (const auto& server : servers) {
-                if (server.getLoad() < minLoad) {
-                    minLoad = server.getLoad();
-                    minLoadServer = server.getId();
+            {
+                PROFILE_ZONE("activeClustering.select");
+                PROFILE_COUNT("activeClustering.serversScanned", servers.size());
+                for (const auto& server : servers) {
+                    if (server.getLoad() < minLoad) {
+                        minLoad = server.getLoad();
+                        minLoadServer = server.getId();
+                    }
                 }
             }
 
@@ -166,27 +179,36 @@ private:
     std::vector<Server> servers;
 };
 
+// Ant Colony Optimization parameters
+struct AntColonyParameters {
+    double alpha = 1.0;      // Pheromone importance factor
+    double beta = 2.0;       // Heuristic information importance factor
+    double rho = 0.5;        // Pheromone evaporation rate
+    double Q = 1.0;          // Pheromone deposit quantity
+    int numIterations = 100;
+};
+
 // Dynamic Ant Colony Optimization algorithm
 class DynamicAntColonyOptimizationLoadBalancing {
 public:
-    DynamicAntColonyOptimizationLoadBalancing(const std::vector<Server>& servers) : servers(servers) {}
+    DynamicAntColonyOptimizationLoadBalancing(const std::vector<Server>& servers, AntColonyParameters parameters = {})
+        : servers(servers), parameters(parameters), gen(std::random_device{}()) {}
 
     void balanceLoad(const std::vector<double>& taskLoads) {
         int numTasks = taskLoads.size();
         int numServers = servers.size();
 
         // Ant Colony Optimization parameters
-        const double alpha = 1.0; // Pheromone importance factor
-        const double beta = 2.0;  // Heuristic information importance factor
-        const double rho = 0.5;   // Pheromone evaporation rate
-        const double Q = 1.0;     // Pheromone deposit quantity
+        const double alpha = parameters.alpha;
+        const double beta = parameters.beta;
+        const double rho = parameters.rho;
+        const double Q = parameters.Q;
 
         // Initialize pheromone trails
         std::vector<std::vector<double>> pheromones(numTasks, std::vector<double>(numServers, 1.0));
 
         // Perform Ant Colony Optimization
-        const int numIterations = 100;
-        for (int iteration = 0; iteration < numIterations; ++iteration) {
+        for (int iteration = 0; iteration < parameters.numIterations; ++iteration) {
             // Move ants
             for (int taskId = 0; taskId < numTasks; ++taskId) {
                 int currentServer = selectNextServer(taskId, pheromones, taskLoads, alpha, beta);
@@ -201,10 +223,14 @@ public:
 
 private:
     std::vector<Server> servers;
+    AntColonyParameters parameters;
+    std::mt19937 gen;
 
     int selectNextServer(int taskId, const std::vector<std::vector<double>>& pheromones,
                          const std::vector<double>& taskLoads, double alpha, double beta) {
+        PROFILE_ZONE("antColony.selectNextServer");
         int numServers = servers.size();
+        PROFILE_COUNT("antColony.probabilitiesComputed", numServers);
 
         // Calculate selection probabilities
         std::vector<double> probabilities(numServers, 0.0);
@@ -217,17 +243,21 @@ private:
         }
 
         // Roulette wheel selection
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::uniform_real_distribution<> dis(0.0, totalProbability);
-        double selection = dis(gen);
+        double selection;
+        {
+            PROFILE_ZONE("antColony.rng");
+            selection = dis(gen);
+        }
         double cumulativeProbability = 0.0;
         for (int serverId = 0; serverId < numServers; ++serverId) {
             cumulativeProbability += probabilities[serverId];
             if (cumulativeProbability >= selection) {
+                PROFILE_COUNT("antColony.serversScanned", serverId + 1);
                 return serverId;
             }
         }
+        PROFILE_COUNT("antColony.serversScanned", numServers);
 
         // If no server is selected, return the last server
         return numServers - 1;
@@ -235,8 +265,10 @@ private:
 
     void updatePheromones(std::vector<std::vector<double>>& pheromones,
                           const std::vector<double>& taskLoads, double rho, double Q) {
+        PROFILE_ZONE("antColony.updatePheromones");
         int numTasks = taskLoads.size();
         int numServers = servers.size();
+        PROFILE_COUNT("antColony.pheromonesUpdated", numTasks * numServers);
 
         // Evaporate pheromones
         for (int taskId = 0; taskId < numTasks; ++taskId) {
@@ -317,6 +349,7 @@ int main() {
 
     for (size_t i = 0; i < NUM_TASKS.size(); ++i) {
         std::vector<double> taskLoads = generateRandomTaskLoads(NUM_TASKS[i]);
+        PROFILE_RESET();
 
         LoadBalancer<RandomLoadBalancing> randomBalancer(capabilities);
         randomBalancer.run(taskLoads);
@@ -342,6 +375,9 @@ int main() {
         dynamicACOBalancer.run(taskLoads);
         durations[4][i] = dynamicACOBalancer.getTotalLoad();
         throughputs[4] = dynamicACOBalancer.getThroughput(NUM_TASKS[i]);
+
+        // Profiled builds print every algorithm's zones and counters for this task count
+        PROFILE_REPORT("Num Tasks: " + std::to_string(NUM_TASKS[i]));
     }
 
     printTable(durations, throughputs, NUM_TASKS);
@@ -0,0 +1,351 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <deque>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <fmt/format.h>
+
+// Event of an integer-tick simulation
+template <typename Payload>
+struct TimedEvent {
+    uint64_t time;
+    Payload payload;
+};
+
+// Event-queue interface: push events, pop the earliest one
+template <typename Queue, typename Payload>
+concept EventQueue = requires(Queue queue, const Queue constQueue, uint64_t time, Payload payload) {
+    queue.push(time, payload);
+    { queue.pop() } -> std::same_as<TimedEvent<Payload>>;
+    { constQueue.empty() } -> std::same_as<bool>;
+    { constQueue.size() } -> std::same_as<size_t>;
+};
+
+// Binary heap: O(log n) push and pop; events with equal times pop in insertion order
+template <typename Payload>
+class BinaryHeapEventQueue {
+public:
+    void push(uint64_t time, const Payload& payload) {
+        entries.push_back({time, nextSequence++, payload});
+        std::push_heap(entries.begin(), entries.end(), std::greater<>());
+    }
+
+    TimedEvent<Payload> pop() {
+        std::pop_heap(entries.begin(), entries.end(), std::greater<>());
+        Entry entry = entries.back();
+        entries.pop_back();
+        return {entry.time, entry.payload};
+    }
+
+    bool empty() const {
+        return entries.empty();
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+private:
+    struct Entry {
+        uint64_t time;
+        uint64_t sequence;
+        Payload payload;
+
+        bool operator>(const Entry& other) const {
+            return time != other.time ? time > other.time : sequence > other.sequence;
+        }
+    };
+
+    std::vector<Entry> entries;
+    uint64_t nextSequence = 0;
+};
+
+// Calendar queue (Brown, 1988): numBuckets days of width ticks each, an event at time t filed
+// under day (t / width) % numBuckets in a sorted bucket. Pop walks the days of the current year
+// from the last popped one, falling back to a direct search when a whole year is empty. The
+// calendar doubles or halves with the population and re-estimates the width from the gaps
+// between the earliest events, so both operations stay O(1) on average for steady traffic.
+// Events with equal times pop in insertion order.
+template <typename Payload>
+class CalendarEventQueue {
+public:
+    CalendarEventQueue() {
+        rebuild(2, 1);
+    }
+
+    void push(uint64_t time, const Payload& payload) {
+        insert({time, payload});
+        ++count;
+        if (count > 2 * buckets.size()) {
+            resize(2 * buckets.size());
+        }
+    }
+
+    TimedEvent<Payload> pop() {
+        if (count == 0) {
+            throw std::runtime_error("Pop from an empty calendar queue");
+        }
+        size_t numBuckets = buckets.size();
+        for (size_t day = 0; day < numBuckets; ++day) {
+            std::deque<TimedEvent<Payload>>& bucket = buckets[currentBucket];
+            if (!bucket.empty() && bucket.front().time < bucketTop) {
+                return take(bucket);
+            }
+            currentBucket = (currentBucket + 1) % numBuckets;
+            bucketTop += width;
+        }
+
+        // A whole year without events: jump to the earliest one directly
+        size_t earliest = 0;
+        for (size_t i = 0; i < numBuckets; ++i) {
+            if (!buckets[i].empty() &&
+                (buckets[earliest].empty() || buckets[i].front().time < buckets[earliest].front().time)) {
+                earliest = i;
+            }
+        }
+        uint64_t time = buckets[earliest].front().time;
+        currentBucket = earliest;
+        bucketTop = (time / width + 1) * width;
+        return take(buckets[earliest]);
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+private:
+    // Buckets are sorted by time; successors are usually among the latest events of their day, so
+    // insertions land near the back
+    std::vector<std::deque<TimedEvent<Payload>>> buckets;
+    uint64_t width = 1;
+    size_t currentBucket = 0;
+    uint64_t bucketTop = 1;  // End of the current day
+    uint64_t lastTime = 0;
+    size_t count = 0;
+
+    void insert(const TimedEvent<Payload>& event) {
+        std::deque<TimedEvent<Payload>>& bucket = buckets[(event.time / width) % buckets.size()];
+        // Behind every event with the same time
+        auto position = std::partition_point(bucket.rbegin(), bucket.rend(),
+                                             [&](const TimedEvent<Payload>& other) { return other.time > event.time; });
+        bucket.insert(position.base(), event);
+    }
+
+    TimedEvent<Payload> take(std::deque<TimedEvent<Payload>>& bucket) {
+        TimedEvent<Payload> event = bucket.front();
+        bucket.pop_front();
+        --count;
+        lastTime = event.time;
+        if (buckets.size() > 2 && count < buckets.size() / 2) {
+            resize(buckets.size() / 2);
+        }
+        return event;
+    }
+
+    // Day width from the earliest events: three times their mean gap, ignoring gaps over twice
+    // the first mean so that a few stragglers do not stretch every day
+    uint64_t estimateWidth() const {
+        std::vector<uint64_t> times;
+        for (const auto& bucket : buckets) {
+            for (const auto& event : bucket) {
+                times.push_back(event.time);
+            }
+        }
+        size_t sample = std::min<size_t>(times.size(), 25);
+        if (sample < 2) {
+            return width;
+        }
+        std::partial_sort(times.begin(), times.begin() + sample, times.end());
+        double meanGap = double(times[sample - 1] - times[0]) / (sample - 1);
+        double total = 0.0;
+        int numGaps = 0;
+        for (size_t i = 1; i < sample; ++i) {
+            double gap = double(times[i] - times[i - 1]);
+            if (gap <= 2 * meanGap) {
+                total += gap;
+                ++numGaps;
+            }
+        }
+        double estimate = numGaps > 0 ? 3 * total / numGaps : 3 * meanGap;
+        return std::max<uint64_t>(1, uint64_t(estimate));
+    }
+
+    void resize(size_t numBuckets) {
+        rebuild(numBuckets, estimateWidth());
+    }
+
+    void rebuild(size_t numBuckets, uint64_t newWidth) {
+        std::vector<std::deque<TimedEvent<Payload>>> oldBuckets(numBuckets);
+        oldBuckets.swap(buckets);
+        width = newWidth;
+        currentBucket = (lastTime / width) % numBuckets;
+        bucketTop = (lastTime / width + 1) * width;
+        for (const auto& bucket : oldBuckets) {
+            for (const auto& event : bucket) {
+                insert(event);
+            }
+        }
+    }
+};
+
+// Radix heap (Ahuja, Mehlhorn, Orlin and Tarjan) for monotone integer times: an event is filed
+// under the bit length of (time XOR last popped time), so bucket 0 holds events at the last time
+// and bucket i those first differing from it in bit i - 1. A pop that finds bucket 0 empty takes
+// the first non-empty bucket, makes its minimum the new last time and redistributes its events
+// into strictly lower buckets. Each event moves down at most 64 times, giving amortized O(log C)
+// operations for a time span C, with sequential vector scans instead of a heap's scattered
+// sift-downs. Times pushed must not precede the last popped one; equal times pop in an
+// unspecified order.
+template <typename Payload>
+class RadixHeapEventQueue {
+public:
+    void push(uint64_t time, const Payload& payload) {
+        if (time < lastTime) {
+            throw std::invalid_argument("Event scheduled before the last popped time");
+        }
+        buckets[getBucket(time)].push_back({time, payload});
+        ++count;
+    }
+
+    TimedEvent<Payload> pop() {
+        if (count == 0) {
+            throw std::runtime_error("Pop from an empty radix heap");
+        }
+        if (buckets[0].empty()) {
+            size_t source = 1;
+            while (buckets[source].empty()) {
+                ++source;
+            }
+            std::vector<TimedEvent<Payload>>& bucket = buckets[source];
+            lastTime = std::min_element(bucket.begin(), bucket.end(), [](const auto& a, const auto& b) {
+                           return a.time < b.time;
+                       })->time;
+            for (const auto& event : bucket) {
+                buckets[getBucket(event.time)].push_back(event);
+            }
+            bucket.clear();
+        }
+        TimedEvent<Payload> event = buckets[0].back();
+        buckets[0].pop_back();
+        --count;
+        return event;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+private:
+    std::array<std::vector<TimedEvent<Payload>>, 65> buckets;
+    uint64_t lastTime = 0;
+    size_t count = 0;
+
+    size_t getBucket(uint64_t time) const {
+        return std::bit_width(time ^ lastTime);
+    }
+};
+
+static_assert(EventQueue<BinaryHeapEventQueue<uint32_t>, uint32_t>);
+static_assert(EventQueue<CalendarEventQueue<uint32_t>, uint32_t>);
+static_assert(EventQueue<RadixHeapEventQueue<uint32_t>, uint32_t>);
+
+// Traffic shape: the distribution of the gap, in ticks (microseconds), between an event and the
+// one it schedules
+struct TrafficShape {
+    std::string name;
+    std::function<uint64_t(std::mt19937_64&)> sampleGap;
+};
+
+std::vector<TrafficShape> getTrafficShapes() {
+    return {
+        // Poisson arrivals, 1 ms apart on average
+        {"Poisson", [](std::mt19937_64& gen) { return uint64_t(std::exponential_distribution<>(1e-3)(gen)); }},
+        // Task loads of 1 to 10 units at 1 ms per unit, as in the load balancing benchmarks
+        {"Uniform Tasks", [](std::mt19937_64& gen) { return uint64_t(std::uniform_real_distribution<>(1e3, 1e4)(gen)); }},
+        // Bursts: nine in ten gaps are short, the rest long (hyperexponential, mean 1.09 ms)
+        {"Bursty", [](std::mt19937_64& gen) {
+             bool burst = std::bernoulli_distribution(0.9)(gen);
+             return uint64_t(std::exponential_distribution<>(burst ? 1e-2 : 1e-4)(gen));
+         }},
+        // Pareto service times with shape 1.5 (infinite variance) and a 100 us minimum
+        {"Heavy-Tailed", [](std::mt19937_64& gen) {
+             double u = std::uniform_real_distribution<>(0.0, 1.0)(gen);
+             return uint64_t(std::min(1e12, 100.0 / std::pow(1.0 - u, 1.0 / 1.5)));
+         }},
+        // Tick-based models: every event lands on a whole 1 ms tick, so many share a time
+        {"Ticked", [](std::mt19937_64& gen) { return 1000 * uint64_t(std::uniform_int_distribution<>(0, 4)(gen)); }}};
+}
+
+// Hold-model benchmark: the queue is filled to its steady size, then every operation pops the
+// earliest event and schedules a successor one sampled gap later. Returns nanoseconds per
+// pop-push pair and a checksum of the popped times, which every correct queue reproduces.
+template <typename Queue>
+    requires EventQueue<Queue, uint32_t>
+double measureHold(const TrafficShape& shape, size_t queueSize, long long numOperations, uint64_t& checksum) {
+    std::mt19937_64 gen(42);
+    Queue queue;
+    for (size_t i = 0; i < queueSize; ++i) {
+        queue.push(shape.sampleGap(gen), uint32_t(i));
+    }
+
+    checksum = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for (long long i = 0; i < numOperations; ++i) {
+        TimedEvent<uint32_t> event = queue.pop();
+        checksum = checksum * 31 + event.time;
+        queue.push(event.time + shape.sampleGap(gen), event.payload);
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(endTime - startTime).count() / numOperations;
+}
+
+int main() {
+    const std::vector<size_t> QUEUE_SIZES = {1000, 100000, 1000000};
+    const long long NUM_OPERATIONS = 1000000;
+
+    std::cout << std::setw(16) << "Traffic Shape" << std::setw(12) << "Queue Size" << std::setw(18)
+              << "Binary Heap (ns)" << std::setw(16) << "Calendar (ns)" << std::setw(18) << "Radix Heap (ns)"
+              << std::setw(12) << "Speedup" << std::setw(12) << "Checksums" << std::endl;
+    std::cout << std::fixed;
+
+    bool consistent = true;
+    for (const auto& shape : getTrafficShapes()) {
+        for (size_t queueSize : QUEUE_SIZES) {
+            uint64_t heapChecksum, calendarChecksum, radixChecksum;
+            double heapTime = measureHold<BinaryHeapEventQueue<uint32_t>>(shape, queueSize, NUM_OPERATIONS,
+                                                                           heapChecksum);
+            double calendarTime = measureHold<CalendarEventQueue<uint32_t>>(shape, queueSize, NUM_OPERATIONS,
+                                                                             calendarChecksum);
+            double radixTime = measureHold<RadixHeapEventQueue<uint32_t>>(shape, queueSize, NUM_OPERATIONS,
+                                                                           radixChecksum);
+            bool match = heapChecksum == calendarChecksum && heapChecksum == radixChecksum;
+            consistent = consistent && match;
+
+            // Speedup of the radix heap over the faster of the other two
+            std::cout << std::setw(16) << shape.name << std::setw(12) << queueSize << std::setw(18)
+                      << std::setprecision(1) << heapTime << std::setw(16) << calendarTime << std::setw(18)
+                      << radixTime << std::setw(11) << std::setprecision(2)
+                      << std::min(heapTime, calendarTime) / radixTime << 'x' << std::setw(12)
+                      << (match ? "match" : "MISMATCH") << std::endl;
+        }
+    }
+
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+// Division-free server index generation for the cheapest balancers. Random picks map a uniform
+// 32-bit value onto [0, numServers) with Lemire's multiply-shift reduction instead of
+// uniform_int_distribution's rejection loop and division, and round-robin wraps with a compare
+// and reset instead of a modulo. IndexStream produces random indices a block at a time from eight
+// interleaved xoshiro128+ generators held in GCC vector lanes, so a decision is a buffered load.
+namespace fast_range {
+
+// Maps a uniform 32-bit value onto [0, range) with one multiply and a shift. Without a rejection
+// step each index is off from 1 / range by less than range / 2^32, about 5e-9 for 20 servers.
+inline uint32_t reduce(uint32_t random, uint32_t range) {
+    return uint32_t((uint64_t(random) * range) >> 32);
+}
+
+// Round-robin position over numServers servers
+class RoundRobinCursor {
+public:
+    RoundRobinCursor(int numServers) : numServers(numServers), currentServer(0) {
+        if (numServers <= 0) {
+            throw std::invalid_argument("Round-robin needs at least one server");
+        }
+    }
+
+    int next() {
+        int serverId = currentServer;
+        currentServer = currentServer + 1 == numServers ? 0 : currentServer + 1;
+        return serverId;
+    }
+
+private:
+    int numServers;
+    int currentServer;
+};
+
+// Uniform random indices in [0, numServers), generated BLOCK_SIZE at a time
+class IndexStream {
+public:
+    static constexpr int LANES = 8;
+    static constexpr int BLOCK_SIZE = 256;
+
+    typedef uint32_t Lane __attribute__((vector_size(LANES * sizeof(uint32_t))));
+    typedef uint64_t WideLane __attribute__((vector_size(LANES * sizeof(uint64_t))));
+
+    IndexStream(int numServers, uint64_t seed) : numServers(numServers), position(BLOCK_SIZE) {
+        if (numServers <= 0) {
+            throw std::invalid_argument("Random selection needs at least one server");
+        }
+        // Every lane gets its own splitmix64-expanded state so the lanes are uncorrelated
+        for (int lane = 0; lane < LANES; ++lane) {
+            for (auto& word : state) {
+                seed += 0x9e3779b97f4a7c15ULL;
+                uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                word[lane] = uint32_t((z ^ (z >> 31)) >> 32) | 1;
+            }
+        }
+    }
+
+    int next() {
+        if (position == BLOCK_SIZE) {
+            refill();
+        }
+        return indices[position++];
+    }
+
+private:
+    int numServers;
+    int position;
+    std::array<Lane, 4> state;
+    alignas(64) std::array<uint32_t, BLOCK_SIZE> indices;
+
+    // One xoshiro128+ step in every lane, then the multiply-shift reduction on 64-bit lanes. The
+    // reduction keeps the high bits of the sum, which are the strong ones in xoshiro128+.
+    void refill() {
+        Lane& s0 = state[0];
+        Lane& s1 = state[1];
+        Lane& s2 = state[2];
+        Lane& s3 = state[3];
+        WideLane range = WideLane{} + uint64_t(numServers);
+        for (int i = 0; i < BLOCK_SIZE; i += LANES) {
+            Lane random = s0 + s3;
+            Lane t = s1 << 9;
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = (s3 << 11) | (s3 >> 21);
+
+            Lane reduced = __builtin_convertvector((__builtin_convertvector(random, WideLane) * range) >> 32, Lane);
+            __builtin_memcpy(&indices[i], &reduced, sizeof(reduced));
+        }
+        position = 0;
+    }
+};
+
+} // namespace fast_range
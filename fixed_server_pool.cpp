@@ -0,0 +1,318 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <span>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fmt/format.h>
+
+// Server pool for the edge balancers: the loads of its servers, with least-loaded and round-robin
+// selection. This general version has its size fixed at compile time and keeps the loads in a
+// std::array; least-loaded selection is a fully unrolled branchless fold with conditional selects,
+// split into independent chains over contiguous blocks of servers so that the compare latencies
+// overlap instead of forming one serial chain of N. The std::dynamic_extent specialization below is
+// the runtime-sized vector version.
+template <size_t N>
+class ServerPool {
+public:
+    static_assert(N > 0, "A server pool needs at least one server");
+
+    static constexpr size_t NUM_CHAINS = N <= 16 ? std::min<size_t>(N, 2) : 4;
+    static constexpr size_t CHAIN_LENGTH = (N + NUM_CHAINS - 1) / NUM_CHAINS;
+
+    ServerPool() : currentServer(0) {
+        loads.fill(0.0);
+    }
+
+    size_t size() const {
+        return N;
+    }
+
+    void addLoad(int serverId, double taskLoad) {
+        loads[serverId] += taskLoad;
+    }
+
+    double getLoad(int serverId) const {
+        return loads[serverId];
+    }
+
+    // Each chain keeps the first minimum of its block, and the chains are combined in block order with
+    // strict compares, so ties go to the lowest id as in a linear scan
+    int selectLeastLoaded() const {
+        std::array<double, NUM_CHAINS> minLoads;
+        std::array<int, NUM_CHAINS> minLoadServers;
+        [&]<size_t... C>(std::index_sequence<C...>) {
+            ((minLoads[C] = loads[C * CHAIN_LENGTH], minLoadServers[C] = C * CHAIN_LENGTH), ...);
+        }(std::make_index_sequence<NUM_CHAINS>{});
+        [&]<size_t... J>(std::index_sequence<J...>) {
+            (foldColumn<J + 1>(minLoads, minLoadServers, std::make_index_sequence<NUM_CHAINS>{}), ...);
+        }(std::make_index_sequence<CHAIN_LENGTH - 1>{});
+
+        double minLoad = minLoads[0];
+        int minLoadServer = minLoadServers[0];
+        [&]<size_t... C>(std::index_sequence<C...>) {
+            ((select(minLoads[C + 1], minLoadServers[C + 1], minLoad, minLoadServer)), ...);
+        }(std::make_index_sequence<NUM_CHAINS - 1>{});
+        return minLoadServer;
+    }
+
+    int selectRoundRobin() {
+        int serverId = currentServer;
+        currentServer = currentServer + 1 == int(N) ? 0 : currentServer + 1;
+        return serverId;
+    }
+
+private:
+    std::array<double, N> loads;
+    int currentServer;
+
+    static_assert((NUM_CHAINS - 1) * CHAIN_LENGTH < N, "Every chain needs at least one server");
+
+    // Takes the candidate when it is strictly smaller; compiles to compares and conditional moves
+    static void select(double load, int serverId, double& minLoad, int& minLoadServer) {
+        bool smaller = load < minLoad;
+        minLoad = smaller ? load : minLoad;
+        minLoadServer = smaller ? serverId : minLoadServer;
+    }
+
+    // Offset J of every chain's block
+    template <size_t J, size_t... C>
+    void foldColumn(std::array<double, NUM_CHAINS>& minLoads, std::array<int, NUM_CHAINS>& minLoadServers,
+                    std::index_sequence<C...>) const {
+        ([&] {
+            constexpr size_t serverId = C * CHAIN_LENGTH + J;
+            if constexpr (serverId < N) {
+                select(loads[serverId], serverId, minLoads[C], minLoadServers[C]);
+            }
+        }(), ...);
+    }
+};
+
+// Runtime-sized pool: the linear scans used by the balancers elsewhere in the tree
+template <>
+class ServerPool<std::dynamic_extent> {
+public:
+    ServerPool(int numServers) : loads(numServers, 0.0), currentServer(0) {}
+
+    size_t size() const {
+        return loads.size();
+    }
+
+    void addLoad(int serverId, double taskLoad) {
+        loads[serverId] += taskLoad;
+    }
+
+    double getLoad(int serverId) const {
+        return loads[serverId];
+    }
+
+    int selectLeastLoaded() const {
+        double minLoad = loads[0];
+        int minLoadServer = 0;
+        for (int serverId = 1; serverId < int(loads.size()); ++serverId) {
+            if (loads[serverId] < minLoad) {
+                minLoad = loads[serverId];
+                minLoadServer = serverId;
+            }
+        }
+        return int(minLoadServer);
+    }
+
+    int selectRoundRobin() {
+        int serverId = currentServer;
+        currentServer = (currentServer + 1) % loads.size();
+        return serverId;
+    }
+
+private:
+    std::vector<double> loads;
+    int currentServer;
+};
+
+template <size_t N>
+using FixedServerPool = ServerPool<N>;
+
+typedef ServerPool<std::dynamic_extent> DynamicServerPool;
+
+#ifdef __AVX__
+// Fixed-size pool with the loads in four-wide lane groups (GCC vector extensions), padded with
+// +inf so that padding never wins a selection, and least-loaded selection as vector argmin trees.
+// Only built with AVX: without it GCC lowers the four-wide compares to scalar code. Even with AVX
+// the scalar fold of ServerPool<N> is faster, so this stays a benchmark comparison.
+template <size_t N>
+class VectorServerPool {
+public:
+    static_assert(N > 0, "A server pool needs at least one server");
+
+    static constexpr size_t LANES = 4;
+    static constexpr size_t NUM_GROUPS = (N + LANES - 1) / LANES;
+    typedef double Lane __attribute__((vector_size(LANES * sizeof(double))));
+    typedef long long LaneMask __attribute__((vector_size(LANES * sizeof(long long))));
+
+    VectorServerPool() : currentServer(0) {
+        for (size_t i = 0; i < NUM_GROUPS * LANES; ++i) {
+            groups[i / LANES][i % LANES] = i < N ? 0.0 : INFINITY;
+        }
+    }
+
+    size_t size() const {
+        return N;
+    }
+
+    // Adds to the whole lane group rather than one element, so that the next selection's packed load
+    // of the group is forwarded from this store instead of stalling on a partial one
+    void addLoad(int serverId, double taskLoad) {
+        LaneMask lane = LANE_IDS == double(serverId % LANES);
+        groups[serverId / LANES] += (Lane)(lane & (LaneMask)(Lane{} + taskLoad));
+    }
+
+    double getLoad(int serverId) const {
+        return groups[serverId / LANES][serverId % LANES];
+    }
+
+    // Branchless least-loaded selection as two argmin trees unrolled over the lane groups: the first
+    // finds the smallest load, the second the smallest id among the servers holding it, so ties go
+    // to the lower id as in a linear scan. Each level of a tree folds the upper half of the groups
+    // onto the lower half with packed minimums, and the last group is reduced across its lanes.
+    int selectLeastLoaded() const {
+        std::array<Lane, NUM_GROUPS> values = groups;
+        double minLoad = reduceMin<NUM_GROUPS>(values);
+
+        LaneMask none = (LaneMask)(Lane{} + INFINITY);
+        std::array<Lane, NUM_GROUPS> candidates;
+        [&]<size_t... G>(std::index_sequence<G...>) {
+            ((candidates[G] = (Lane)(((LaneMask)SERVER_IDS[G] & (groups[G] == minLoad)) |
+                                     (none & (groups[G] != minLoad)))),
+             ...);
+        }(std::make_index_sequence<NUM_GROUPS>{});
+        return int(reduceMin<NUM_GROUPS>(candidates));
+    }
+
+    int selectRoundRobin() {
+        int serverId = currentServer;
+        currentServer = currentServer + 1 == int(N) ? 0 : currentServer + 1;
+        return serverId;
+    }
+
+private:
+    std::array<Lane, NUM_GROUPS> groups;
+    int currentServer;
+
+    static constexpr Lane LANE_IDS = {0.0, 1.0, 2.0, 3.0};
+
+    // Server ids laid out like the loads. They are kept as doubles so that every compare stays in
+    // the floating-point unit: packed 64-bit integer compares need SSE4.2 and are scalarized below it.
+    static inline const std::array<Lane, NUM_GROUPS> SERVER_IDS = [] {
+        std::array<Lane, NUM_GROUPS> ids;
+        for (size_t group = 0; group < NUM_GROUPS; ++group) {
+            ids[group] = LANE_IDS + double(group * LANES);
+        }
+        return ids;
+    }();
+
+    // Minimum over the first Count groups, folding the upper half onto the lower one per level, then
+    // across the lanes of the last group
+    template <size_t Count>
+    static double reduceMin(std::array<Lane, NUM_GROUPS>& values) {
+        if constexpr (Count == 1) {
+            Lane& lane = values[0];
+            return std::min(std::min(lane[0], lane[1]), std::min(lane[2], lane[3]));
+        } else {
+            constexpr size_t half = (Count + 1) / 2;
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                ((values[I] = values[I + half] < values[I] ? values[I + half] : values[I]), ...);
+            }(std::make_index_sequence<Count / 2>{});
+            return reduceMin<half>(values);
+        }
+    }
+};
+
+#endif
+
+// Active Clustering on a pool: every task goes to the least-loaded server
+template <typename Pool>
+class ActiveClusteringLoadBalancing {
+public:
+    ActiveClusteringLoadBalancing(Pool& pool) : pool(pool) {}
+
+    // Returns a checksum of the chosen servers, so runs on different pools can be compared
+    uint64_t balanceLoad(const std::vector<double>& taskLoads) {
+        uint64_t checksum = 0;
+        for (const auto& taskLoad : taskLoads) {
+            int serverId = pool.selectLeastLoaded();
+            pool.addLoad(serverId, taskLoad);
+            checksum = checksum * 31 + serverId;
+        }
+        return checksum;
+    }
+
+private:
+    Pool& pool;
+};
+
+// Helper function to generate random task loads
+std::vector<double> generateRandomTaskLoads(int numTasks) {
+    std::vector<double> taskLoads(numTasks);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> dis(1.0, 10.0);
+    for (int i = 0; i < numTasks; ++i) {
+        taskLoads[i] = dis(gen);
+    }
+    return taskLoads;
+}
+
+// Helper function to time Active Clustering on a pool; returns nanoseconds per task
+template <typename Pool>
+double measure(Pool& pool, const std::vector<double>& taskLoads, uint64_t& checksum) {
+    ActiveClusteringLoadBalancing<Pool> algorithm(pool);
+    auto startTime = std::chrono::steady_clock::now();
+    checksum = algorithm.balanceLoad(taskLoads);
+    auto endTime = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(endTime - startTime).count() / taskLoads.size();
+}
+
+// Helper function to compare the fixed pool of N servers with the dynamic one and print a row
+template <size_t N>
+bool compare(const std::vector<double>& taskLoads) {
+    DynamicServerPool dynamicPool(N);
+    FixedServerPool<N> fixedPool;
+    uint64_t dynamicChecksum, fixedChecksum;
+    double dynamicTime = measure(dynamicPool, taskLoads, dynamicChecksum);
+    double fixedTime = measure(fixedPool, taskLoads, fixedChecksum);
+    bool match = dynamicChecksum == fixedChecksum;
+
+    std::cout << std::setw(12) << N << std::setw(20) << dynamicTime << std::setw(20) << fixedTime << std::setw(11)
+              << dynamicTime / fixedTime << 'x';
+#ifdef __AVX__
+    VectorServerPool<N> vectorPool;
+    uint64_t vectorChecksum;
+    double vectorTime = measure(vectorPool, taskLoads, vectorChecksum);
+    match = match && dynamicChecksum == vectorChecksum;
+    std::cout << std::setw(20) << vectorTime << std::setw(11) << dynamicTime / vectorTime << 'x';
+#endif
+    std::cout << std::setw(16) << (match ? "match" : "MISMATCH") << std::endl;
+    return match;
+}
+
+int main() {
+    const int NUM_TASKS = 1000000;
+    std::vector<double> taskLoads = generateRandomTaskLoads(NUM_TASKS);
+
+    std::cout << std::setw(12) << "Servers" << std::setw(20) << "Dynamic (ns/task)" << std::setw(20)
+              << "Fixed (ns/task)" << std::setw(12) << "Speedup";
+#ifdef __AVX__
+    std::cout << std::setw(20) << "Vector (ns/task)" << std::setw(12) << "Speedup";
+#endif
+    std::cout << std::setw(16) << "Assignments" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    bool consistent = [&]<size_t... N>(std::index_sequence<N...>) {
+        return (compare<N>(taskLoads) & ...);
+    }(std::index_sequence<4, 8, 12, 16, 20, 24, 32, 48, 64>{});
+
+    return consistent ? 0 : 1;
+}
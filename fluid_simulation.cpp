@@ -0,0 +1,406 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <fmt/format.h>
+
+// Mean-field (fluid) model of JSQ(d) on an infinite fleet of identical single-slot servers:
+// x[k - 1] = s_k is the fraction of servers holding at least k requests (s_0 = 1), and
+//   ds_k/dt = lambda(t) (s_{k-1}^d - s_k^d) - mu (s_k - s_{k+1}).
+// d = 1 is random dispatching. Queue lengths are truncated at maxQueueLength.
+class PowerOfDFluidModel {
+public:
+    PowerOfDFluidModel(int d, int maxQueueLength, std::function<double(double)> utilization, double serviceRate)
+        : d(d), maxQueueLength(maxQueueLength), utilization(std::move(utilization)), serviceRate(serviceRate) {}
+
+    size_t getDimension() const {
+        return maxQueueLength;
+    }
+
+    // Every server starts empty
+    std::vector<double> getInitialState() const {
+        return std::vector<double>(maxQueueLength, 0.0);
+    }
+
+    void getDerivative(double time, const std::vector<double>& x, std::vector<double>& dx) const {
+        double arrivalRate = utilization(time) * serviceRate;
+        double previousPower = 1.0; // s_0^d
+        for (int k = 1; k <= maxQueueLength; ++k) {
+            double current = x[k - 1];
+            double next = k < maxQueueLength ? x[k] : 0.0;
+            double power = std::pow(std::max(current, 0.0), d);
+            dx[k - 1] = arrivalRate * (previousPower - power) - serviceRate * (current - next);
+            previousPower = power;
+        }
+    }
+
+    // Fraction of servers with exactly k requests, for k = 0..maxQueueLength
+    std::vector<double> getOccupancy(const std::vector<double>& x) const {
+        std::vector<double> occupancy(maxQueueLength + 1);
+        for (int k = 0; k <= maxQueueLength; ++k) {
+            double atLeast = k == 0 ? 1.0 : x[k - 1];
+            double atLeastNext = k < maxQueueLength ? x[k] : 0.0;
+            occupancy[k] = atLeast - atLeastNext;
+        }
+        return occupancy;
+    }
+
+private:
+    int d;
+    int maxQueueLength;
+    std::function<double(double)> utilization;
+    double serviceRate;
+};
+
+// Fluid model of round-robin: each server sees every n-th arrival of the fleet, an Erlang-n
+// renewal stream, which is not Markov in the queue length alone. The arrival process is
+// represented by numPhases exponential phases (Erlang-numPhases, which tends to the deterministic
+// spacing of large fleets), and x[phase * (maxQueueLength + 1) + k] is the fraction of servers in
+// that arrival phase holding k requests. Phases start spread evenly, as round-robin staggers them.
+class RoundRobinFluidModel {
+public:
+    RoundRobinFluidModel(int numPhases, int maxQueueLength, std::function<double(double)> utilization,
+                         double serviceRate)
+        : numPhases(numPhases), maxQueueLength(maxQueueLength), utilization(std::move(utilization)),
+          serviceRate(serviceRate) {}
+
+    size_t getDimension() const {
+        return size_t(numPhases) * (maxQueueLength + 1);
+    }
+
+    std::vector<double> getInitialState() const {
+        std::vector<double> x(getDimension(), 0.0);
+        for (int phase = 0; phase < numPhases; ++phase) {
+            x[getIndex(phase, 0)] = 1.0 / numPhases;
+        }
+        return x;
+    }
+
+    void getDerivative(double time, const std::vector<double>& x, std::vector<double>& dx) const {
+        double phaseRate = numPhases * utilization(time) * serviceRate;
+        for (int phase = 0; phase < numPhases; ++phase) {
+            for (int k = 0; k <= maxQueueLength; ++k) {
+                double flow = -phaseRate * x[getIndex(phase, k)];
+                // Arrival phases advance; completing the last one delivers a request
+                if (phase > 0) {
+                    flow += phaseRate * x[getIndex(phase - 1, k)];
+                } else {
+                    if (k > 0) {
+                        flow += phaseRate * x[getIndex(numPhases - 1, k - 1)];
+                    }
+                    if (k == maxQueueLength) {
+                        flow += phaseRate * x[getIndex(numPhases - 1, k)]; // Truncated: the request is lost
+                    }
+                }
+                // Service completions
+                if (k > 0) {
+                    flow -= serviceRate * x[getIndex(phase, k)];
+                }
+                if (k < maxQueueLength) {
+                    flow += serviceRate * x[getIndex(phase, k + 1)];
+                }
+                dx[getIndex(phase, k)] = flow;
+            }
+        }
+    }
+
+    std::vector<double> getOccupancy(const std::vector<double>& x) const {
+        std::vector<double> occupancy(maxQueueLength + 1, 0.0);
+        for (int phase = 0; phase < numPhases; ++phase) {
+            for (int k = 0; k <= maxQueueLength; ++k) {
+                occupancy[k] += x[getIndex(phase, k)];
+            }
+        }
+        return occupancy;
+    }
+
+private:
+    int numPhases;
+    int maxQueueLength;
+    std::function<double(double)> utilization;
+    double serviceRate;
+
+    size_t getIndex(int phase, int k) const {
+        return size_t(phase) * (maxQueueLength + 1) + k;
+    }
+};
+
+// Adaptive-step Dormand-Prince 5(4) integrator: each step is accepted when the embedded error
+// estimate is within absoluteTolerance + relativeTolerance * |x| in every component, and the step
+// size follows the error with the usual 0.9 * err^(-1/5) controller
+class DormandPrinceSolver {
+public:
+    struct Stats {
+        int acceptedSteps = 0;
+        int rejectedSteps = 0;
+        long long derivativeEvaluations = 0;
+    };
+
+    DormandPrinceSolver(double absoluteTolerance = 1e-9, double relativeTolerance = 1e-7)
+        : absoluteTolerance(absoluteTolerance), relativeTolerance(relativeTolerance) {}
+
+    // Advances x from time from to time to
+    template <typename Model>
+    void integrate(const Model& model, std::vector<double>& x, double from, double to) {
+        size_t n = x.size();
+        std::vector<std::vector<double>> k(7, std::vector<double>(n));
+        std::vector<double> stage(n), next(n);
+        double time = from;
+        if (step <= 0) {
+            step = 1e-3;
+        }
+
+        model.getDerivative(time, x, k[0]);
+        ++stats.derivativeEvaluations;
+        while (time < to) {
+            double h = std::min(step, to - time);
+            for (int s = 1; s < 7; ++s) {
+                for (size_t i = 0; i < n; ++i) {
+                    double sum = 0.0;
+                    for (int j = 0; j < s; ++j) {
+                        sum += A[s][j] * k[j][i];
+                    }
+                    stage[i] = x[i] + h * sum;
+                }
+                model.getDerivative(time + C[s] * h, stage, k[s]);
+                ++stats.derivativeEvaluations;
+            }
+            // The seventh stage is evaluated at the fifth-order solution
+            next = stage;
+
+            double error = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                double estimate = 0.0;
+                for (int j = 0; j < 7; ++j) {
+                    estimate += E[j] * k[j][i];
+                }
+                double scale = absoluteTolerance + relativeTolerance * std::max(std::abs(x[i]), std::abs(next[i]));
+                error = std::max(error, std::abs(h * estimate) / scale);
+            }
+
+            if (error <= 1.0) {
+                time += h;
+                x = next;
+                k[0] = k[6]; // First same as last
+                ++stats.acceptedSteps;
+            } else {
+                ++stats.rejectedSteps;
+            }
+            double factor = error == 0.0 ? 5.0 : std::clamp(0.9 * std::pow(error, -0.2), 0.2, 5.0);
+            step = h * factor;
+        }
+    }
+
+    const Stats& getStats() const {
+        return stats;
+    }
+
+private:
+    static constexpr double C[7] = {0.0, 1.0 / 5, 3.0 / 10, 4.0 / 5, 8.0 / 9, 1.0, 1.0};
+    static constexpr double A[7][6] = {
+        {},
+        {1.0 / 5},
+        {3.0 / 40, 9.0 / 40},
+        {44.0 / 45, -56.0 / 15, 32.0 / 9},
+        {19372.0 / 6561, -25360.0 / 2187, 64448.0 / 6561, -212.0 / 729},
+        {9017.0 / 3168, -355.0 / 33, 46732.0 / 5247, 49.0 / 176, -5103.0 / 18656},
+        {35.0 / 384, 0.0, 500.0 / 1113, 125.0 / 192, -2187.0 / 6784, 11.0 / 84}};
+    // Fifth-order weights minus the embedded fourth-order weights
+    static constexpr double E[7] = {35.0 / 384 - 5179.0 / 57600,     0.0,
+                                    500.0 / 1113 - 7571.0 / 16695,   125.0 / 192 - 393.0 / 640,
+                                    -2187.0 / 6784 + 92097.0 / 339200, 11.0 / 84 - 187.0 / 2100,
+                                    -1.0 / 40};
+
+    double absoluteTolerance;
+    double relativeTolerance;
+    double step = 0;
+    Stats stats;
+};
+
+// Dispatching policies simulated by the discrete-event reference
+enum class Policy {
+    Random,
+    RoundRobin,
+    PowerOfD
+};
+
+// Discrete-event reference: numServers single-slot FIFO servers with exponential service. Each
+// server keeps the departure times of its requests, so queue lengths at arrivals and at snapshot
+// times are exact. Returns the occupancy (fraction of servers with k requests) at every snapshot.
+std::vector<std::vector<double>> simulateOccupancy(Policy policy, int d, int numServers,
+                                                   const std::function<double(double)>& utilization,
+                                                   double serviceRate, const std::vector<double>& snapshotTimes,
+                                                   int maxQueueLength, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::exponential_distribution<> unitDis(1.0);
+    std::exponential_distribution<> serviceDis(serviceRate);
+    std::uniform_int_distribution<> serverDis(0, numServers - 1);
+    std::vector<std::deque<double>> departures(numServers);
+    int currentServer = 0;
+
+    auto getQueueLength = [&](int serverId, double time) {
+        std::deque<double>& server = departures[serverId];
+        while (!server.empty() && server.front() <= time) {
+            server.pop_front();
+        }
+        return int(server.size());
+    };
+
+    std::vector<std::vector<double>> snapshots;
+    double time = 0.0;
+    size_t nextSnapshot = 0;
+    while (nextSnapshot < snapshotTimes.size()) {
+        // Piecewise-constant rate: the next arrival uses the rate at the current time
+        time += unitDis(gen) / (numServers * utilization(time) * serviceRate);
+        while (nextSnapshot < snapshotTimes.size() && snapshotTimes[nextSnapshot] <= time) {
+            std::vector<double> occupancy(maxQueueLength + 1, 0.0);
+            for (int serverId = 0; serverId < numServers; ++serverId) {
+                occupancy[std::min(getQueueLength(serverId, snapshotTimes[nextSnapshot]), maxQueueLength)] +=
+                    1.0 / numServers;
+            }
+            snapshots.push_back(occupancy);
+            ++nextSnapshot;
+        }
+
+        int serverId = 0;
+        switch (policy) {
+        case Policy::Random:
+            serverId = serverDis(gen);
+            break;
+        case Policy::RoundRobin:
+            serverId = currentServer;
+            currentServer = (currentServer + 1) % numServers;
+            break;
+        case Policy::PowerOfD: {
+            serverId = serverDis(gen);
+            int minLength = getQueueLength(serverId, time);
+            for (int choice = 1; choice < d; ++choice) {
+                int candidate = serverDis(gen);
+                int length = getQueueLength(candidate, time);
+                if (length < minLength) {
+                    minLength = length;
+                    serverId = candidate;
+                }
+            }
+            break;
+        }
+        }
+        std::deque<double>& server = departures[serverId];
+        server.push_back(std::max(time, server.empty() ? 0.0 : server.back()) + serviceDis(gen));
+    }
+    return snapshots;
+}
+
+// Helper function to compute the mean queue length of an occupancy distribution
+double getMeanQueueLength(const std::vector<double>& occupancy) {
+    double mean = 0.0;
+    for (size_t k = 0; k < occupancy.size(); ++k) {
+        mean += k * occupancy[k];
+    }
+    return mean;
+}
+
+// Helper function to integrate a fluid model through the snapshot times; returns the occupancy at
+// each of them, the solve time in milliseconds and the solver statistics
+template <typename Model>
+std::vector<std::vector<double>> solveOccupancy(const Model& model, const std::vector<double>& snapshotTimes,
+                                                double& duration, DormandPrinceSolver::Stats& stats) {
+    DormandPrinceSolver solver;
+    std::vector<double> x = model.getInitialState();
+    std::vector<std::vector<double>> snapshots;
+    auto startTime = std::chrono::steady_clock::now();
+    double time = 0.0;
+    for (double snapshotTime : snapshotTimes) {
+        solver.integrate(model, x, time, snapshotTime);
+        time = snapshotTime;
+        snapshots.push_back(model.getOccupancy(x));
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    duration = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    stats = solver.getStats();
+    return snapshots;
+}
+
+int main() {
+    const int NUM_SERVERS = 10000;       // Discrete-event reference fleet
+    const int MAX_QUEUE_LENGTH = 100;
+    const int ROUND_ROBIN_PHASES = 16;
+    const double SERVICE_RATE = 1.0;
+    const double STEP_TIME = 100.0;
+    const double END_TIME = 200.0;
+    const int SHOWN_LENGTHS = 6;
+
+    // Capacity-planning scenario: the fleet runs at 70% and steps up to 95% at STEP_TIME
+    auto utilization = [STEP_TIME](double time) { return time < STEP_TIME ? 0.7 : 0.95; };
+
+    // Snapshots before the step, densely through the transient after it, then out to END_TIME
+    std::vector<double> snapshotTimes = {STEP_TIME / 2, STEP_TIME};
+    for (double offset : {1.0, 2.0, 5.0, 10.0, 20.0}) {
+        snapshotTimes.push_back(STEP_TIME + offset);
+    }
+    snapshotTimes.push_back((STEP_TIME + END_TIME) / 2);
+    snapshotTimes.push_back(END_TIME);
+
+    struct Scenario {
+        std::string name;
+        Policy policy;
+        int d;
+    };
+    std::vector<Scenario> scenarios = {
+        {"Random", Policy::Random, 1}, {"JSQ(2)", Policy::PowerOfD, 2}, {"JSQ(3)", Policy::PowerOfD, 3},
+        {"Round-Robin", Policy::RoundRobin, 1}};
+
+    std::cout << std::fixed;
+    for (const auto& scenario : scenarios) {
+        double duration;
+        DormandPrinceSolver::Stats stats;
+        std::vector<std::vector<double>> fluid;
+        if (scenario.policy == Policy::RoundRobin) {
+            RoundRobinFluidModel model(ROUND_ROBIN_PHASES, MAX_QUEUE_LENGTH, utilization, SERVICE_RATE);
+            fluid = solveOccupancy(model, snapshotTimes, duration, stats);
+        } else {
+            PowerOfDFluidModel model(scenario.d, MAX_QUEUE_LENGTH, utilization, SERVICE_RATE);
+            fluid = solveOccupancy(model, snapshotTimes, duration, stats);
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        std::vector<std::vector<double>> simulated =
+            simulateOccupancy(scenario.policy, scenario.d, NUM_SERVERS, utilization, SERVICE_RATE, snapshotTimes,
+                              MAX_QUEUE_LENGTH, 42);
+        auto endTime = std::chrono::steady_clock::now();
+
+        std::cout << scenario.name << ": fluid " << std::setprecision(2) << duration << " ms (" << stats.acceptedSteps
+                  << " steps, " << stats.rejectedSteps << " rejected), discrete-event " << NUM_SERVERS << " servers "
+                  << std::setprecision(0) << std::chrono::duration<double, std::milli>(endTime - startTime).count()
+                  << " ms" << std::endl;
+        std::cout << std::setw(8) << "Time" << std::setw(12) << "Mean Fluid" << std::setw(12) << "Mean DES"
+                  << std::setw(10) << "TV Dist";
+        for (int k = 0; k < SHOWN_LENGTHS; ++k) {
+            std::cout << std::setw(14) << ("P(Q=" + std::to_string(k) + ") F/D");
+        }
+        std::cout << std::endl;
+        for (size_t i = 0; i < snapshotTimes.size(); ++i) {
+            double totalVariation = 0.0;
+            for (int k = 0; k <= MAX_QUEUE_LENGTH; ++k) {
+                totalVariation += std::abs(fluid[i][k] - simulated[i][k]) / 2;
+            }
+            std::cout << std::setw(8) << std::setprecision(0) << snapshotTimes[i] << std::setw(12)
+                      << std::setprecision(3) << getMeanQueueLength(fluid[i]) << std::setw(12)
+                      << getMeanQueueLength(simulated[i]) << std::setw(10) << totalVariation;
+            for (int k = 0; k < SHOWN_LENGTHS; ++k) {
+                std::cout << std::setw(8) << fluid[i][k] << '/' << std::setw(5) << std::setprecision(2)
+                          << simulated[i][k] << std::setprecision(3);
+            }
+            std::cout << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,486 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <span>
+#include <string>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <fmt/format.h>
+#include "work_stealing_pool.h"
+#include "fast_range.h"
+
+// Dependency between two tasks: the consumer starts only after the producer finished and, when the
+// two run on different servers, after its output data has been transferred
+struct Edge {
+    int from;
+    int to;
+    double data;
+};
+
+// Task graph in compressed sparse row form. The successors of task i are
+// successors[successorOffsets[i] .. successorOffsets[i + 1]) with the data of each edge alongside;
+// predecessors are stored the same way, so both directions are contiguous scans.
+class TaskGraph {
+public:
+    TaskGraph(std::vector<double> work, const std::vector<Edge>& edges) : work(std::move(work)) {
+        int numTasks = this->work.size();
+        for (const auto& edge : edges) {
+            if (edge.from < 0 || edge.from >= numTasks || edge.to < 0 || edge.to >= numTasks) {
+                throw std::invalid_argument("Edge refers to a task outside the graph");
+            }
+        }
+        buildRows(edges, numTasks, false, successorOffsets, successors, successorData);
+        buildRows(edges, numTasks, true, predecessorOffsets, predecessors, predecessorData);
+    }
+
+    int getNumTasks() const {
+        return work.size();
+    }
+
+    long long getNumEdges() const {
+        return successors.size();
+    }
+
+    double getWork(int task) const {
+        return work[task];
+    }
+
+    std::span<const int> getSuccessors(int task) const {
+        return {successors.data() + successorOffsets[task], successors.data() + successorOffsets[task + 1]};
+    }
+
+    std::span<const double> getSuccessorData(int task) const {
+        return {successorData.data() + successorOffsets[task], successorData.data() + successorOffsets[task + 1]};
+    }
+
+    std::span<const int> getPredecessors(int task) const {
+        return {predecessors.data() + predecessorOffsets[task], predecessors.data() + predecessorOffsets[task + 1]};
+    }
+
+    std::span<const double> getPredecessorData(int task) const {
+        return {predecessorData.data() + predecessorOffsets[task],
+                predecessorData.data() + predecessorOffsets[task + 1]};
+    }
+
+private:
+    std::vector<double> work;
+    std::vector<long long> successorOffsets;
+    std::vector<int> successors;
+    std::vector<double> successorData;
+    std::vector<long long> predecessorOffsets;
+    std::vector<int> predecessors;
+    std::vector<double> predecessorData;
+
+    // Counting sort of the edges by source (or by target when reversed)
+    static void buildRows(const std::vector<Edge>& edges, int numTasks, bool reversed, std::vector<long long>& offsets,
+                          std::vector<int>& neighbors, std::vector<double>& data) {
+        offsets.assign(numTasks + 1, 0);
+        for (const auto& edge : edges) {
+            ++offsets[(reversed ? edge.to : edge.from) + 1];
+        }
+        for (int task = 0; task < numTasks; ++task) {
+            offsets[task + 1] += offsets[task];
+        }
+        neighbors.resize(edges.size());
+        data.resize(edges.size());
+        std::vector<long long> next(offsets.begin(), offsets.end() - 1);
+        for (const auto& edge : edges) {
+            long long position = next[reversed ? edge.to : edge.from]++;
+            neighbors[position] = reversed ? edge.from : edge.to;
+            data[position] = edge.data;
+        }
+    }
+};
+
+// Heterogeneous servers connected by a uniform network: a task takes work / capability on a
+// server, and an edge between tasks on different servers costs data / bandwidth
+struct Platform {
+    std::vector<int> capabilities;
+    double bandwidth;
+
+    double getMeanInverseCapability() const {
+        double sum = 0;
+        for (int capability : capabilities) {
+            sum += 1.0 / capability;
+        }
+        return sum / capabilities.size();
+    }
+};
+
+// Tasks grouped by height, the longest path to a sink in edges: every successor of a task is in a
+// lower level, so the tasks of one level can be ranked independently once the levels below are done
+struct TaskLevels {
+    std::vector<int> offsets;
+    std::vector<int> tasks;
+
+    int getNumLevels() const {
+        return offsets.size() - 1;
+    }
+
+    std::span<const int> getLevel(int level) const {
+        return {tasks.data() + offsets[level], tasks.data() + offsets[level + 1]};
+    }
+};
+
+// Helper function to compute the levels with Kahn's algorithm run from the sinks
+TaskLevels computeLevels(const TaskGraph& graph) {
+    int numTasks = graph.getNumTasks();
+    std::vector<int> pendingSuccessors(numTasks);
+    std::vector<int> current;
+    for (int task = 0; task < numTasks; ++task) {
+        pendingSuccessors[task] = graph.getSuccessors(task).size();
+        if (pendingSuccessors[task] == 0) {
+            current.push_back(task);
+        }
+    }
+
+    TaskLevels levels;
+    levels.offsets.push_back(0);
+    levels.tasks.reserve(numTasks);
+    std::vector<int> next;
+    while (!current.empty()) {
+        levels.tasks.insert(levels.tasks.end(), current.begin(), current.end());
+        levels.offsets.push_back(levels.tasks.size());
+        next.clear();
+        for (int task : current) {
+            for (int predecessor : graph.getPredecessors(task)) {
+                if (--pendingSuccessors[predecessor] == 0) {
+                    next.push_back(predecessor);
+                }
+            }
+        }
+        std::swap(current, next);
+    }
+    if (int(levels.tasks.size()) != numTasks) {
+        throw std::runtime_error("Task graph has a cycle");
+    }
+    return levels;
+}
+
+// Upward ranks of HEFT: rank(i) = mean execution time of i + max over successors j of (mean
+// transfer time of i -> j + rank(j)), the length of the critical path from i to the exit. Levels
+// are ranked bottom-up; with a pool, each level large enough to pay for the fork is split into
+// chunks run as a task group.
+std::vector<double> computeUpwardRanks(const TaskGraph& graph, const TaskLevels& levels, const Platform& platform,
+                                       WorkStealingPool* pool) {
+    const int CHUNK_SIZE = 1024;
+    double meanInverseCapability = platform.getMeanInverseCapability();
+    std::vector<double> ranks(graph.getNumTasks());
+
+    auto rankTasks = [&](std::span<const int> tasks) {
+        for (int task : tasks) {
+            std::span<const int> successors = graph.getSuccessors(task);
+            std::span<const double> data = graph.getSuccessorData(task);
+            double longestPath = 0;
+            for (size_t i = 0; i < successors.size(); ++i) {
+                longestPath = std::max(longestPath, data[i] / platform.bandwidth + ranks[successors[i]]);
+            }
+            ranks[task] = graph.getWork(task) * meanInverseCapability + longestPath;
+        }
+    };
+
+    for (int level = 0; level < levels.getNumLevels(); ++level) {
+        std::span<const int> tasks = levels.getLevel(level);
+        if (!pool || tasks.size() < 2 * CHUNK_SIZE) {
+            rankTasks(tasks);
+            continue;
+        }
+        WorkStealingPool::TaskGroup group(*pool);
+        for (size_t begin = 0; begin < tasks.size(); begin += CHUNK_SIZE) {
+            group.run([&, begin] { rankTasks(tasks.subspan(begin, std::min<size_t>(CHUNK_SIZE, tasks.size() - begin))); });
+        }
+        group.wait();
+    }
+    return ranks;
+}
+
+struct Schedule {
+    std::vector<int> servers;
+    std::vector<double> finishTimes;
+    double makespan;
+};
+
+// Server state seen by the placement policies while a schedule is built
+struct SchedulingState {
+    const TaskGraph& graph;
+    const Platform& platform;
+    std::vector<double> availableTimes; // When each server finishes its last task
+    std::vector<double> busyTimes;      // Execution time assigned to each server so far
+    Schedule schedule;
+};
+
+// Helper function to compute when the inputs of a task can be on each server. An input reaches
+// its producer's server when the producer finishes and every other server data / bandwidth later,
+// so every server but the one holding the latest-arriving input sees the same time; only that one
+// server needs the maximum over the inputs produced elsewhere. This keeps a task at
+// O(predecessors + servers) instead of O(predecessors * servers).
+void computeDataReadyTimes(const SchedulingState& state, int task, std::vector<double>& dataReadyTimes) {
+    const Schedule& schedule = state.schedule;
+    std::span<const int> predecessors = state.graph.getPredecessors(task);
+    std::span<const double> data = state.graph.getPredecessorData(task);
+
+    double latestArrival = 0;
+    int latestServer = -1;
+    for (size_t i = 0; i < predecessors.size(); ++i) {
+        double arrival = schedule.finishTimes[predecessors[i]] + data[i] / state.platform.bandwidth;
+        if (arrival > latestArrival) {
+            latestArrival = arrival;
+            latestServer = schedule.servers[predecessors[i]];
+        }
+    }
+    std::fill(dataReadyTimes.begin(), dataReadyTimes.end(), latestArrival);
+    if (latestServer < 0) {
+        return;
+    }
+
+    double localReady = 0;
+    for (size_t i = 0; i < predecessors.size(); ++i) {
+        int server = schedule.servers[predecessors[i]];
+        double finishTime = schedule.finishTimes[predecessors[i]];
+        localReady = std::max(localReady, server == latestServer ? finishTime
+                                                                 : finishTime + data[i] / state.platform.bandwidth);
+    }
+    dataReadyTimes[latestServer] = localReady;
+}
+
+// HEFT placement: the server on which the task finishes earliest, counting transfers
+class HeftPolicy {
+public:
+    HeftPolicy(const Platform& platform) : dataReadyTimes(platform.capabilities.size()) {}
+
+    int selectServer(const SchedulingState& state, int task) {
+        computeDataReadyTimes(state, task, dataReadyTimes);
+        double bestFinish = INFINITY;
+        int bestServer = 0;
+        for (int server = 0; server < int(dataReadyTimes.size()); ++server) {
+            double finish = std::max(state.availableTimes[server], dataReadyTimes[server]) +
+                            state.graph.getWork(task) / state.platform.capabilities[server];
+            if (finish < bestFinish) {
+                bestFinish = finish;
+                bestServer = server;
+            }
+        }
+        return bestServer;
+    }
+
+private:
+    std::vector<double> dataReadyTimes;
+};
+
+// The independent-task balancers, placing each ready task without looking at its inputs
+class RandomPolicy {
+public:
+    RandomPolicy(const Platform& platform) : indices(platform.capabilities.size(), 42) {}
+
+    int selectServer(const SchedulingState&, int) {
+        return indices.next();
+    }
+
+private:
+    fast_range::IndexStream indices;
+};
+
+class RoundRobinPolicy {
+public:
+    RoundRobinPolicy(const Platform& platform) : cursor(platform.capabilities.size()) {}
+
+    int selectServer(const SchedulingState&, int) {
+        return cursor.next();
+    }
+
+private:
+    fast_range::RoundRobinCursor cursor;
+};
+
+// Active Clustering: the server with the least execution time assigned so far
+class ActiveClusteringPolicy {
+public:
+    ActiveClusteringPolicy(const Platform&) {}
+
+    int selectServer(const SchedulingState& state, int) {
+        double minLoad = state.busyTimes[0];
+        int minLoadServer = 0;
+        for (int server = 1; server < int(state.busyTimes.size()); ++server) {
+            if (state.busyTimes[server] < minLoad) {
+                minLoad = state.busyTimes[server];
+                minLoadServer = server;
+            }
+        }
+        return minLoadServer;
+    }
+};
+
+// List scheduling: ready tasks wait in a max-heap on upward rank and the policy places the highest
+// one, which starts once its server is free and its inputs have arrived. With HeftPolicy this is
+// HEFT without insertion into idle gaps: a server runs its tasks in placement order.
+template <typename Policy>
+Schedule listSchedule(const TaskGraph& graph, const Platform& platform, const std::vector<double>& ranks) {
+    int numTasks = graph.getNumTasks();
+    int numServers = platform.capabilities.size();
+    SchedulingState state{graph, platform, std::vector<double>(numServers, 0.0), std::vector<double>(numServers, 0.0),
+                          {std::vector<int>(numTasks, -1), std::vector<double>(numTasks, 0.0), 0.0}};
+    Policy policy(platform);
+    std::vector<double> dataReadyTimes(numServers);
+
+    std::vector<int> pendingPredecessors(numTasks);
+    std::priority_queue<std::pair<double, int>> ready;
+    for (int task = 0; task < numTasks; ++task) {
+        pendingPredecessors[task] = graph.getPredecessors(task).size();
+        if (pendingPredecessors[task] == 0) {
+            ready.push({ranks[task], task});
+        }
+    }
+
+    while (!ready.empty()) {
+        int task = ready.top().second;
+        ready.pop();
+
+        int server = policy.selectServer(state, task);
+        computeDataReadyTimes(state, task, dataReadyTimes);
+        double executionTime = graph.getWork(task) / platform.capabilities[server];
+        double finishTime = std::max(state.availableTimes[server], dataReadyTimes[server]) + executionTime;
+        state.schedule.servers[task] = server;
+        state.schedule.finishTimes[task] = finishTime;
+        state.availableTimes[server] = finishTime;
+        state.busyTimes[server] += executionTime;
+        state.schedule.makespan = std::max(state.schedule.makespan, finishTime);
+
+        for (int successor : graph.getSuccessors(task)) {
+            if (--pendingPredecessors[successor] == 0) {
+                ready.push({ranks[successor], successor});
+            }
+        }
+    }
+    return state.schedule;
+}
+
+// Helper function to compute a lower bound on any makespan: the longer of the critical path with
+// every task on the fastest server and free transfers, and the total work spread perfectly over
+// the capability of all servers
+double computeMakespanBound(const TaskGraph& graph, const TaskLevels& levels, const Platform& platform) {
+    int fastest = *std::max_element(platform.capabilities.begin(), platform.capabilities.end());
+    std::vector<double> pathLengths(graph.getNumTasks());
+    double criticalPath = 0;
+    double totalWork = 0;
+    for (int level = 0; level < levels.getNumLevels(); ++level) {
+        for (int task : levels.getLevel(level)) {
+            double longestPath = 0;
+            for (int successor : graph.getSuccessors(task)) {
+                longestPath = std::max(longestPath, pathLengths[successor]);
+            }
+            pathLengths[task] = graph.getWork(task) / fastest + longestPath;
+            criticalPath = std::max(criticalPath, pathLengths[task]);
+            totalWork += graph.getWork(task);
+        }
+    }
+    double totalCapability = 0;
+    for (int capability : platform.capabilities) {
+        totalCapability += capability;
+    }
+    return std::max(criticalPath, totalWork / totalCapability);
+}
+
+// Helper function to generate a random DAG: task i depends on up to maxPredecessors earlier tasks
+// drawn from the window of tasks just before it, which bounds how far the graph can run in parallel
+TaskGraph generateTaskGraph(int numTasks, int maxPredecessors, int window, uint64_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<> workDis(1.0, 10.0);
+    std::uniform_real_distribution<> dataDis(0.0, 5.0);
+    std::uniform_int_distribution<> countDis(0, maxPredecessors);
+
+    std::vector<double> work(numTasks);
+    std::vector<Edge> edges;
+    edges.reserve((long long)numTasks * maxPredecessors / 2);
+    for (int task = 0; task < numTasks; ++task) {
+        work[task] = workDis(gen);
+        int first = std::max(0, task - window);
+        if (task == 0) {
+            continue;
+        }
+        std::uniform_int_distribution<> predecessorDis(first, task - 1);
+        int numPredecessors = std::min(countDis(gen), task - first);
+        for (int i = 0; i < numPredecessors; ++i) {
+            // Duplicate edges are harmless: the later transfer dominates
+            edges.push_back({predecessorDis(gen), task, dataDis(gen)});
+        }
+    }
+    return TaskGraph(std::move(work), edges);
+}
+
+// Helper function to generate random capabilities for servers
+std::vector<int> generateRandomCapabilities(int numServers, int minCapability, int maxCapability, uint64_t seed) {
+    std::vector<int> capabilities(numServers);
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> dis(minCapability, maxCapability);
+    for (int i = 0; i < numServers; ++i) {
+        capabilities[i] = dis(gen);
+    }
+    return capabilities;
+}
+
+// Helper function to time one scheduler and print its row
+template <typename Policy>
+void runScheduler(const std::string& name, const TaskGraph& graph, const Platform& platform,
+                  const std::vector<double>& ranks, double bound) {
+    auto startTime = std::chrono::steady_clock::now();
+    Schedule schedule = listSchedule<Policy>(graph, platform, ranks);
+    auto endTime = std::chrono::steady_clock::now();
+    double duration = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    std::cout << std::setw(24) << name << std::setw(16) << schedule.makespan << std::setw(16)
+              << schedule.makespan / bound << std::setw(20) << duration << std::endl;
+}
+
+int main() {
+    const int NUM_SERVERS = 64;
+    const int MAX_PREDECESSORS = 6;
+    const int WINDOW = 50000;
+    const uint64_t SEED = 42;
+    std::vector<int> numTasks = {10000, 100000, 1000000};
+
+    Platform platform;
+    platform.capabilities = generateRandomCapabilities(NUM_SERVERS, 1, 100, SEED);
+    platform.bandwidth = 20.0;
+    int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    WorkStealingPool pool(numThreads);
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (int tasks : numTasks) {
+        TaskGraph graph = generateTaskGraph(tasks, MAX_PREDECESSORS, WINDOW, SEED);
+
+        auto startTime = std::chrono::steady_clock::now();
+        TaskLevels levels = computeLevels(graph);
+        auto levelTime = std::chrono::steady_clock::now();
+        std::vector<double> sequentialRanks = computeUpwardRanks(graph, levels, platform, nullptr);
+        auto sequentialTime = std::chrono::steady_clock::now();
+        std::vector<double> ranks = computeUpwardRanks(graph, levels, platform, &pool);
+        auto parallelTime = std::chrono::steady_clock::now();
+        if (ranks != sequentialRanks) {
+            throw std::runtime_error("Parallel upward ranks differ from the sequential ones");
+        }
+        double bound = computeMakespanBound(graph, levels, platform);
+
+        std::cout << "Tasks: " << graph.getNumTasks() << ", edges: " << graph.getNumEdges()
+                  << ", levels: " << levels.getNumLevels() << ", servers: " << NUM_SERVERS << std::endl;
+        std::cout << "Levels: " << std::chrono::duration<double, std::milli>(levelTime - startTime).count()
+                  << " ms, upward ranks: "
+                  << std::chrono::duration<double, std::milli>(sequentialTime - levelTime).count()
+                  << " ms sequential, "
+                  << std::chrono::duration<double, std::milli>(parallelTime - sequentialTime).count() << " ms on "
+                  << numThreads << " threads" << std::endl;
+        std::cout << std::setw(24) << "Algorithm" << std::setw(16) << "Makespan" << std::setw(16) << "Makespan/Bound"
+                  << std::setw(20) << "Schedule Time (ms)" << std::endl;
+        runScheduler<RandomPolicy>("Random", graph, platform, ranks, bound);
+        runScheduler<RoundRobinPolicy>("Round-Robin", graph, platform, ranks, bound);
+        runScheduler<ActiveClusteringPolicy>("Active Clustering", graph, platform, ranks, bound);
+        runScheduler<HeftPolicy>("HEFT", graph, platform, ranks, bound);
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,403 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <fmt/format.h>
+#include "profiling.h"
+
+// Server class
+class Server {
+public:
+    Server(int id, int capability) : id(id), capability(capability), load(0) {}
+
+    void addLoad(double taskLoad) {
+        load += taskLoad;
+    }
+
+    void resetLoad() {
+        load = 0;
+    }
+
+    double getLoad() const {
+        return load;
+    }
+
+    // Load relative to the server capability, after taking a task of the given load, so servers of
+    // unequal capability compare fairly
+    double getRelativeLoad(double taskLoad = 0.0) const {
+        return (load + taskLoad) / capability;
+    }
+
+    int getId() const {
+        return id;
+    }
+
+    int getCapability() const {
+        return capability;
+    }
+
+private:
+    int id;
+    int capability;
+    double load;
+};
+
+// Zone class: summary of a contiguous range of servers (a rack or a zone)
+class Zone {
+public:
+    Zone(int firstServer, int numServers, double capability)
+        : firstServer(firstServer), numServers(numServers), capability(capability), load(0) {}
+
+    void addLoad(double taskLoad) {
+        load += taskLoad;
+    }
+
+    // Load relative to the zone capability, so zones of unequal size compare fairly
+    double getRelativeLoad() const {
+        return load / capability;
+    }
+
+    int getFirstServer() const {
+        return firstServer;
+    }
+
+    int getNumServers() const {
+        return numServers;
+    }
+
+private:
+    int firstServer;
+    int numServers;
+    double capability;
+    double load;
+};
+
+// Load Balancer class. The algorithm is built with the balancer, so setup such as the zone
+// summaries stays out of run.
+template <typename LoadBalancingAlgorithm>
+class LoadBalancer {
+public:
+    LoadBalancer(const std::vector<int>& capabilities) : servers(createServers(capabilities)), algorithm(servers) {}
+
+    void run(const std::vector<double>& taskLoads) {
+        PROFILE_ZONE("balanceLoad");
+        algorithm.balanceLoad(taskLoads);
+    }
+
+    double getTotalLoad() const {
+        double totalLoad = 0.0;
+        for (const auto& server : servers) {
+            totalLoad += server.getLoad();
+        }
+        return totalLoad;
+    }
+
+    // Balance quality: the highest relative load over its lower bound, the larger of the mean
+    // relative load and the largest task on the most capable server (1 is optimal)
+    double getImbalance(const std::vector<double>& taskLoads) const {
+        double totalCapability = 0.0;
+        int maxCapability = 0;
+        double maxRelativeLoad = 0.0;
+        for (const auto& server : servers) {
+            totalCapability += server.getCapability();
+            maxCapability = std::max(maxCapability, server.getCapability());
+            maxRelativeLoad = std::max(maxRelativeLoad, server.getRelativeLoad());
+        }
+        double maxTaskLoad = *std::max_element(taskLoads.begin(), taskLoads.end());
+        return maxRelativeLoad / std::max(getTotalLoad() / totalCapability, maxTaskLoad / maxCapability);
+    }
+
+private:
+    std::vector<Server> servers;
+    LoadBalancingAlgorithm algorithm;
+
+    static std::vector<Server> createServers(const std::vector<int>& capabilities) {
+        std::vector<Server> servers;
+        int numServers = capabilities.size();
+        servers.reserve(numServers);
+        for (int i = 0; i < numServers; ++i) {
+            servers.push_back(Server(i, capabilities[i]));
+        }
+        return servers;
+    }
+};
+
+// Active Clustering algorithm (flat least-loaded scan over every server)
+class ActiveClusteringLoadBalancing {
+public:
+    ActiveClusteringLoadBalancing(std::vector<Server>& servers) : servers(servers) {}
+
+    void balanceLoad(const std::vector<double>& taskLoads) {
+        for (const auto& taskLoad : taskLoads) {
+            // Find the server with the minimum relative load once it takes the task
+            double minLoad = servers[0].getRelativeLoad(taskLoad);
+            int minLoadServer = servers[0].getId();
+            {
+                PROFILE_ZONE("activeClustering.select");
+                PROFILE_COUNT("activeClustering.serversScanned", servers.size());
+                for (const auto& server : servers) {
+                    if (server.getRelativeLoad(taskLoad) < minLoad) {
+                        minLoad = server.getRelativeLoad(taskLoad);
+                        minLoadServer = server.getId();
+                    }
+                }
+            }
+
+            // Assign the task to the server with the minimum relative load
+            servers[minLoadServer].addLoad(taskLoad);
+        }
+    }
+
+private:
+    std::vector<Server>& servers;
+};
+
+// Zone selection: sample two zones and keep the less loaded one (JSQ(2) over zones)
+class PowerOfTwoZoneSelection {
+public:
+    PowerOfTwoZoneSelection() : gen(std::random_device{}()) {}
+
+    int selectZone(const std::vector<Zone>& zones) {
+        std::uniform_int_distribution<> dis(0, zones.size() - 1);
+        int first = dis(gen);
+        int second = dis(gen);
+        return zones[second].getRelativeLoad() < zones[first].getRelativeLoad() ? second : first;
+    }
+
+private:
+    std::mt19937 gen;
+};
+
+// Zone selection: the least loaded zone, kept at the root of a tournament tree over the zone
+// summaries. A placement replays only the matches on its zone's path, so a decision costs
+// O(log zones) instead of a scan of every zone.
+class LeastLoadedZoneSelection {
+public:
+    void build(const std::vector<Zone>& zones) {
+        numLeaves = 1;
+        while (numLeaves < int(zones.size())) {
+            numLeaves *= 2;
+        }
+        // Padding leaves hold -1 and lose every match
+        tree.assign(2 * numLeaves, -1);
+        for (int zoneId = 0; zoneId < int(zones.size()); ++zoneId) {
+            tree[numLeaves + zoneId] = zoneId;
+        }
+        for (int node = numLeaves - 1; node >= 1; --node) {
+            tree[node] = winner(zones, tree[2 * node], tree[2 * node + 1]);
+        }
+    }
+
+    int selectZone(const std::vector<Zone>&) {
+        return tree[1];
+    }
+
+    void onZoneChanged(const std::vector<Zone>& zones, int zoneId) {
+        int matches = 0;
+        for (int node = (numLeaves + zoneId) / 2; node >= 1; node /= 2) {
+            tree[node] = winner(zones, tree[2 * node], tree[2 * node + 1]);
+            ++matches;
+        }
+        PROFILE_COUNT("hierarchical.zoneMatches", matches);
+    }
+
+private:
+    int numLeaves = 0;
+    std::vector<int> tree; // Winning zone of each match; leaves from numLeaves on
+
+    // Less loaded of two zones, the lower id on a tie
+    static int winner(const std::vector<Zone>& zones, int first, int second) {
+        if (first < 0 || second < 0) {
+            return std::max(first, second);
+        }
+        return zones[second].getRelativeLoad() < zones[first].getRelativeLoad() ? second : first;
+    }
+};
+
+// Server selection: least relative load after the task, scanning the servers of one zone
+class LeastLoadedServerSelection {
+public:
+    int selectServer(const std::vector<Server>& servers, const Zone& zone, double taskLoad) {
+        PROFILE_COUNT("hierarchical.serversScanned", zone.getNumServers());
+        int first = zone.getFirstServer();
+        int last = first + zone.getNumServers();
+        int minLoadServer = first;
+        for (int serverId = first + 1; serverId < last; ++serverId) {
+            if (servers[serverId].getRelativeLoad(taskLoad) < servers[minLoadServer].getRelativeLoad(taskLoad)) {
+                minLoadServer = serverId;
+            }
+        }
+        return minLoadServer;
+    }
+};
+
+// Server selection: JSQ(2) on relative load after the task, restricted to the servers of one zone
+class PowerOfTwoServerSelection {
+public:
+    PowerOfTwoServerSelection() : gen(std::random_device{}()) {}
+
+    int selectServer(const std::vector<Server>& servers, const Zone& zone, double taskLoad) {
+        std::uniform_int_distribution<> dis(0, zone.getNumServers() - 1);
+        int first = zone.getFirstServer() + dis(gen);
+        int second = zone.getFirstServer() + dis(gen);
+        return servers[second].getRelativeLoad(taskLoad) < servers[first].getRelativeLoad(taskLoad) ? second : first;
+    }
+
+private:
+    std::mt19937 gen;
+};
+
+// Hierarchical algorithm: pick a zone from the zone summaries, then a server inside that zone.
+// Each decision touches the zone summaries plus one zone's servers, so the working set stays
+// cache-resident no matter how many servers the pool has.
+template <typename ZoneSelection, typename ServerSelection>
+class HierarchicalLoadBalancing {
+public:
+    static constexpr int DEFAULT_ZONE_SIZE = 256;
+
+    HierarchicalLoadBalancing(std::vector<Server>& servers, int zoneSize = DEFAULT_ZONE_SIZE) : servers(servers) {
+        PROFILE_ZONE("hierarchical.buildZones");
+        int numServers = servers.size();
+        for (int first = 0; first < numServers; first += zoneSize) {
+            int numZoneServers = std::min(zoneSize, numServers - first);
+            double capability = 0.0;
+            double load = 0.0;
+            for (int serverId = first; serverId < first + numZoneServers; ++serverId) {
+                capability += servers[serverId].getCapability();
+                load += servers[serverId].getLoad();
+            }
+            zones.push_back(Zone(first, numZoneServers, capability));
+            zones.back().addLoad(load);
+        }
+        if constexpr (requires { zoneSelection.build(zones); }) {
+            zoneSelection.build(zones);
+        }
+    }
+
+    void balanceLoad(const std::vector<double>& taskLoads) {
+        for (const auto& taskLoad : taskLoads) {
+            int zoneId;
+            int serverId;
+            {
+                PROFILE_ZONE("hierarchical.selectZone");
+                zoneId = zoneSelection.selectZone(zones);
+            }
+            {
+                PROFILE_ZONE("hierarchical.selectServer");
+                serverId = serverSelection.selectServer(servers, zones[zoneId], taskLoad);
+            }
+
+            // Keep the zone summary in step with its servers
+            servers[serverId].addLoad(taskLoad);
+            zones[zoneId].addLoad(taskLoad);
+            if constexpr (requires { zoneSelection.onZoneChanged(zones, zoneId); }) {
+                zoneSelection.onZoneChanged(zones, zoneId);
+            }
+        }
+    }
+
+private:
+    std::vector<Server>& servers;
+    std::vector<Zone> zones;
+    ZoneSelection zoneSelection;
+    ServerSelection serverSelection;
+};
+
+// Helper function to generate random task loads
+std::vector<double> generateRandomTaskLoads(int numTasks) {
+    std::vector<double> taskLoads(numTasks);
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> dis(1.0, 10.0);
+    for (int i = 0; i < numTasks; ++i) {
+        taskLoads[i] = dis(gen);
+    }
+    return taskLoads;
+}
+
+// Helper function to generate random capabilities for servers
+std::vector<int> generateRandomCapabilities(int numServers, int minCapability, int maxCapability) {
+    std::vector<int> capabilities(numServers);
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> dis(minCapability, maxCapability);
+    for (int i = 0; i < numServers; ++i) {
+        capabilities[i] = dis(gen);
+    }
+    return capabilities;
+}
+
+// Helper function to time one algorithm's placements and record the balance they reached
+template <typename LoadBalancingAlgorithm>
+double measure(const std::vector<int>& capabilities, const std::vector<double>& taskLoads, double& imbalance) {
+    LoadBalancer<LoadBalancingAlgorithm> balancer(capabilities);
+    auto startTime = std::chrono::steady_clock::now();
+    balancer.run(taskLoads);
+    auto endTime = std::chrono::steady_clock::now();
+    imbalance = balancer.getImbalance(taskLoads);
+    return std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+}
+
+// Helper function to print the table
+void printTable(const std::vector<std::string>& algorithms, const std::vector<std::vector<double>>& durations,
+                const std::vector<std::vector<double>>& imbalances, const std::vector<int>& numServers) {
+    std::cout << std::setw(28) << "Load Balancing Algorithm";
+    for (const auto& numServer : numServers) {
+        std::cout << std::setw(34) << "Num Servers: " << std::setw(8) << numServer;
+    }
+    std::cout << std::endl;
+
+    std::cout << std::setw(28) << "";
+    for (size_t i = 0; i < numServers.size(); ++i) {
+        std::cout << std::setw(22) << "Execution Time (μs)" << std::setw(20) << "Max Load/Bound";
+    }
+    std::cout << std::endl;
+
+    std::cout << std::fixed;
+    for (size_t i = 0; i < algorithms.size(); ++i) {
+        std::cout << std::setw(28) << algorithms[i];
+        for (size_t j = 0; j < durations[i].size(); ++j) {
+            std::cout << std::setw(20) << std::setprecision(0) << durations[i][j] << std::setw(20)
+                      << std::setprecision(2) << imbalances[i][j];
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main() {
+    const int NUM_TASKS = 1000;
+    const int MIN_CAPABILITY = 1;
+    const int MAX_CAPABILITY = 100;
+    const std::vector<int> NUM_SERVERS = {10000, 100000, 1000000};
+
+    std::vector<std::string> algorithms = {"Active Clustering (flat)", "JSQ(2) zone / least-loaded",
+                                           "Least-loaded zone / JSQ(2)", "JSQ(2) zone / JSQ(2)"};
+    std::vector<std::vector<double>> durations(algorithms.size(), std::vector<double>(NUM_SERVERS.size()));
+    std::vector<std::vector<double>> imbalances(algorithms.size(), std::vector<double>(NUM_SERVERS.size()));
+
+    std::vector<double> taskLoads = generateRandomTaskLoads(NUM_TASKS);
+
+    for (size_t i = 0; i < NUM_SERVERS.size(); ++i) {
+        std::vector<int> capabilities = generateRandomCapabilities(NUM_SERVERS[i], MIN_CAPABILITY, MAX_CAPABILITY);
+        PROFILE_RESET();
+
+        durations[0][i] = measure<ActiveClusteringLoadBalancing>(capabilities, taskLoads, imbalances[0][i]);
+        durations[1][i] = measure<HierarchicalLoadBalancing<PowerOfTwoZoneSelection, LeastLoadedServerSelection>>(
+            capabilities, taskLoads, imbalances[1][i]);
+        durations[2][i] = measure<HierarchicalLoadBalancing<LeastLoadedZoneSelection, PowerOfTwoServerSelection>>(
+            capabilities, taskLoads, imbalances[2][i]);
+        durations[3][i] = measure<HierarchicalLoadBalancing<PowerOfTwoZoneSelection, PowerOfTwoServerSelection>>(
+            capabilities, taskLoads, imbalances[3][i]);
+
+        // Profiled builds print every algorithm's zones and counters for this pool size
+        PROFILE_REPORT("Num Servers: " + std::to_string(NUM_SERVERS[i]));
+    }
+
+    printTable(algorithms, durations, imbalances, NUM_SERVERS);
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+#include <cstdint>
+#include <fmt/format.h>
+#include "fast_range.h"
+
+// Result of one index generator: time per decision and how uniformly it spread the decisions
+struct GeneratorResult {
+    double nanosecondsPerDecision;
+    double chiSquare;
+};
+
+// Helper function to run a generator for numDecisions decisions over numServers servers, counting
+// the decisions per server as a balancer adding load would
+GeneratorResult measure(const std::function<void(std::vector<uint64_t>&, int)>& generate, int numServers,
+                        int numDecisions) {
+    std::vector<uint64_t> counts(numServers, 0);
+    auto startTime = std::chrono::steady_clock::now();
+    generate(counts, numDecisions);
+    auto endTime = std::chrono::steady_clock::now();
+
+    double expected = double(numDecisions) / numServers;
+    double chiSquare = 0;
+    for (uint64_t count : counts) {
+        chiSquare += (count - expected) * (count - expected) / expected;
+    }
+    return {std::chrono::duration<double, std::nano>(endTime - startTime).count() / numDecisions, chiSquare};
+}
+
+int main() {
+    const int NUM_DECISIONS = 20000000;
+    const uint64_t SEED = 42;
+    std::vector<int> numServers = {20, 1000};
+
+    // Each generator runs its whole decision loop, so std::function is called once per run, not per decision
+    std::vector<std::pair<std::string, std::function<void(std::vector<uint64_t>&, int)>>> generators = {
+        {"Random (uniform_int_distribution)",
+         [&](std::vector<uint64_t>& counts, int numDecisions) {
+             std::mt19937 gen(SEED);
+             std::uniform_int_distribution<> dis(0, counts.size() - 1);
+             for (int i = 0; i < numDecisions; ++i) {
+                 ++counts[dis(gen)];
+             }
+         }},
+        {"Random (multiply-shift)",
+         [&](std::vector<uint64_t>& counts, int numDecisions) {
+             std::mt19937 gen(SEED);
+             uint32_t range = counts.size();
+             for (int i = 0; i < numDecisions; ++i) {
+                 ++counts[fast_range::reduce(gen(), range)];
+             }
+         }},
+        {"Random (buffered xoshiro128+ x8)",
+         [&](std::vector<uint64_t>& counts, int numDecisions) {
+             fast_range::IndexStream indices(counts.size(), SEED);
+             for (int i = 0; i < numDecisions; ++i) {
+                 ++counts[indices.next()];
+             }
+         }},
+        {"Round-Robin (modulo)",
+         [&](std::vector<uint64_t>& counts, int numDecisions) {
+             int currentServer = 0;
+             for (int i = 0; i < numDecisions; ++i) {
+                 ++counts[currentServer];
+                 currentServer = (currentServer + 1) % counts.size();
+             }
+         }},
+        {"Round-Robin (compare and reset)",
+         [&](std::vector<uint64_t>& counts, int numDecisions) {
+             fast_range::RoundRobinCursor cursor(counts.size());
+             for (int i = 0; i < numDecisions; ++i) {
+                 ++counts[cursor.next()];
+             }
+         }}};
+
+    for (int servers : numServers) {
+        // Chi-square with servers - 1 degrees of freedom: about servers - 1 for a uniform generator
+        std::cout << "Servers: " << servers << " (uniform chi-square ~ " << servers - 1 << ")" << std::endl;
+        std::cout << std::setw(36) << "Index Generator" << std::setw(20) << "Time (ns/decision)" << std::setw(16)
+                  << "Chi-Square" << std::endl;
+        std::cout << std::fixed;
+        for (const auto& [name, generate] : generators) {
+            GeneratorResult result = measure(generate, servers, NUM_DECISIONS);
+            std::cout << std::setw(36) << name << std::setw(20) << std::setprecision(3)
+                      << result.nanosecondsPerDecision << std::setw(16) << std::setprecision(1) << result.chiSquare
+                      << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
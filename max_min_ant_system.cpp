@@ -0,0 +1,451 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <optional>
+#include <sstream>
+#include <fmt/format.h>
+
+// Server class
+class Server {
+public:
+    Server(int id, int capability) : id(id), capability(capability), load(0) {}
+
+    void addLoad(double taskLoad) {
+        load += taskLoad;
+    }
+
+    void resetLoad() {
+        load = 0;
+    }
+
+    double getLoad() const {
+        return load;
+    }
+
+    int getId() const {
+        return id;
+    }
+
+    int getCapability() const {
+        return capability;
+    }
+
+private:
+    int id;
+    int capability;
+    double load;
+};
+
+// Ant Colony Optimization parameters
+struct AntColonyParameters {
+    double alpha = 1.0;      // Pheromone importance factor
+    double beta = 2.0;       // Heuristic information importance factor
+    double rho = 0.5;        // Pheromone evaporation rate
+    double Q = 1.0;          // Pheromone deposit quantity
+    int numIterations = 100;
+};
+
+// MAX-MIN Ant System parameters on top of the common ones
+struct MaxMinAntSystemParameters {
+    double xi = 0.1;           // Local update rate: how far a chosen cell decays towards tauMin
+    double q0 = 0.9;           // Probability that an ant exploits the best cell instead of sampling
+    double tauRatio = 0.01;    // tauMin as a fraction of tauMax
+    int globalBestPeriod = 5;  // Every this many iterations the global best deposits instead
+};
+
+// Ant Colony Optimization algorithm with a seeded generator. Every iteration evaporates and deposits
+// on every (task, server) cell, weighted by Q / (load + task).
+class AntColonyOptimizationLoadBalancing {
+public:
+    AntColonyOptimizationLoadBalancing(std::vector<Server>& servers, AntColonyParameters parameters, uint64_t seed)
+        : servers(servers), parameters(parameters), gen(seed) {}
+
+    void balanceLoad(const std::vector<double>& taskLoads) {
+        int numTasks = taskLoads.size();
+        int numServers = servers.size();
+
+        // Initialize pheromone trails
+        std::vector<std::vector<double>> pheromones(numTasks, std::vector<double>(numServers, 1.0));
+
+        // Ants work on tentative loads (work per unit of capability); the best assignment is kept
+        std::vector<int> assignment(numTasks);
+        std::vector<int> bestAssignment(numTasks);
+        double bestMaxLoad = INFINITY;
+        history.clear();
+
+        for (int iteration = 0; iteration < parameters.numIterations; ++iteration) {
+            std::vector<double> loads(numServers, 0.0);
+
+            // Move ants
+            for (int taskId = 0; taskId < numTasks; ++taskId) {
+                int currentServer = selectNextServer(taskId, pheromones, loads, taskLoads);
+                loads[currentServer] += taskLoads[taskId] / servers[currentServer].getCapability();
+                assignment[taskId] = currentServer;
+            }
+
+            double maxLoad = *std::max_element(loads.begin(), loads.end());
+            if (maxLoad < bestMaxLoad) {
+                bestMaxLoad = maxLoad;
+                bestAssignment = assignment;
+            }
+            history.push_back(bestMaxLoad);
+
+            // Update pheromones
+            updatePheromones(pheromones, loads, taskLoads);
+        }
+
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            servers[bestAssignment[taskId]].addLoad(taskLoads[taskId]);
+        }
+    }
+
+    // Best makespan (in units of time) found after each iteration
+    const std::vector<double>& getHistory() const {
+        return history;
+    }
+
+private:
+    std::vector<Server>& servers;
+    AntColonyParameters parameters;
+    std::mt19937_64 gen;
+    std::vector<double> history;
+
+    int selectNextServer(int taskId, const std::vector<std::vector<double>>& pheromones, const std::vector<double>& loads,
+                         const std::vector<double>& taskLoads) {
+        int numServers = servers.size();
+
+        // Calculate selection probabilities
+        std::vector<double> probabilities(numServers, 0.0);
+        double totalProbability = 0.0;
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            double pheromone = pheromones[taskId][serverId];
+            double taskTime = taskLoads[taskId] / servers[serverId].getCapability();
+            double heuristic = 1.0 / (std::pow(loads[serverId] + taskTime, parameters.beta));
+            probabilities[serverId] = std::pow(pheromone, parameters.alpha) * heuristic;
+            totalProbability += probabilities[serverId];
+        }
+
+        // Roulette wheel selection
+        std::uniform_real_distribution<> dis(0.0, totalProbability);
+        double selection = dis(gen);
+        double cumulativeProbability = 0.0;
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            cumulativeProbability += probabilities[serverId];
+            if (cumulativeProbability >= selection) {
+                return serverId;
+            }
+        }
+
+        // If no server is selected, return the last server
+        return numServers - 1;
+    }
+
+    void updatePheromones(std::vector<std::vector<double>>& pheromones, const std::vector<double>& loads,
+                          const std::vector<double>& taskLoads) {
+        int numTasks = taskLoads.size();
+        int numServers = servers.size();
+
+        // Evaporate pheromones
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            for (int serverId = 0; serverId < numServers; ++serverId) {
+                pheromones[taskId][serverId] *= (1.0 - parameters.rho);
+            }
+        }
+
+        // Deposit pheromones based on server loads
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            for (int serverId = 0; serverId < numServers; ++serverId) {
+                double taskTime = taskLoads[taskId] / servers[serverId].getCapability();
+                double deltaPheromone = parameters.Q / (loads[serverId] + taskTime);
+                pheromones[taskId][serverId] += deltaPheromone;
+            }
+        }
+    }
+};
+
+// MAX-MIN Ant System variant with Ant Colony System updates:
+// - Only one assignment deposits per iteration: the iteration best, or the global best every
+//   globalBestPeriod iterations. It reinforces just its own (task, server) cells, so the global
+//   update is O(tasks) instead of O(tasks x servers); cells that are not reinforced are left as is
+//   (the ACS form of evaporation).
+// - Pheromone is clamped to [tauMin, tauMax]. tauMax = Q / (rho * best makespan) is the fixed point
+//   of repeated deposits, and tauMin = tauRatio * tauMax keeps every server reachable. When the
+//   best makespan improves tauMax changes, and cells are clamped to the new bounds as they are read
+//   rather than in an O(tasks x servers) sweep.
+// - Every choice an ant makes decays that cell towards tauMin (ACS local update), so the next ants
+//   are pushed to explore unless the global update reinforces the choice.
+// - With probability q0 an ant takes the best-weighted server instead of sampling (ACS
+//   pseudo-random proportional rule).
+class MaxMinAntSystemLoadBalancing {
+public:
+    MaxMinAntSystemLoadBalancing(std::vector<Server>& servers, AntColonyParameters parameters,
+                                 MaxMinAntSystemParameters maxMinParameters, uint64_t seed)
+        : servers(servers), parameters(parameters), maxMinParameters(maxMinParameters), gen(seed) {}
+
+    void balanceLoad(const std::vector<double>& taskLoads) {
+        int numTasks = taskLoads.size();
+        int numServers = servers.size();
+
+        // Until an ant finds an assignment, the bounds come from the capability-proportional lower
+        // bound on the makespan; every trail starts at tauMax
+        double totalLoad = 0.0;
+        double totalCapability = 0.0;
+        for (double taskLoad : taskLoads) {
+            totalLoad += taskLoad;
+        }
+        for (const auto& server : servers) {
+            totalCapability += server.getCapability();
+        }
+        setBounds(totalLoad / totalCapability);
+        std::vector<std::vector<double>> pheromones(numTasks, std::vector<double>(numServers, tauMax));
+
+        std::vector<int> bestAssignment(numTasks);
+        double bestMaxLoad = INFINITY;
+
+        std::vector<int> assignment(numTasks);
+        std::vector<double> probabilities(numServers);
+        history.clear();
+
+        for (int iteration = 0; iteration < parameters.numIterations; ++iteration) {
+            std::vector<double> loads(numServers, 0.0);
+
+            // Move ants
+            for (int taskId = 0; taskId < numTasks; ++taskId) {
+                int currentServer = selectNextServer(pheromones[taskId], loads, taskLoads[taskId], probabilities);
+                loads[currentServer] += taskLoads[taskId] / servers[currentServer].getCapability();
+                assignment[taskId] = currentServer;
+
+                // Local update
+                double& pheromone = pheromones[taskId][currentServer];
+                pheromone = (1.0 - maxMinParameters.xi) * std::min(pheromone, tauMax) + maxMinParameters.xi * tauMin;
+            }
+
+            double maxLoad = *std::max_element(loads.begin(), loads.end());
+            if (maxLoad < bestMaxLoad) {
+                bestMaxLoad = maxLoad;
+                bestAssignment = assignment;
+                setBounds(bestMaxLoad);
+            }
+            history.push_back(bestMaxLoad);
+
+            // Global update by the iteration best or the global best
+            bool useGlobalBest = (iteration + 1) % maxMinParameters.globalBestPeriod == 0;
+            const std::vector<int>& depositor = useGlobalBest ? bestAssignment : assignment;
+            double deltaPheromone = parameters.Q / (useGlobalBest ? bestMaxLoad : maxLoad);
+            for (int taskId = 0; taskId < numTasks; ++taskId) {
+                double& pheromone = pheromones[taskId][depositor[taskId]];
+                pheromone = std::clamp((1.0 - parameters.rho) * pheromone + deltaPheromone, tauMin, tauMax);
+            }
+        }
+
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            servers[bestAssignment[taskId]].addLoad(taskLoads[taskId]);
+        }
+    }
+
+    // Best makespan (in units of time) found after each iteration
+    const std::vector<double>& getHistory() const {
+        return history;
+    }
+
+private:
+    std::vector<Server>& servers;
+    AntColonyParameters parameters;
+    MaxMinAntSystemParameters maxMinParameters;
+    std::mt19937_64 gen;
+    std::vector<double> history;
+    double tauMin = 0;
+    double tauMax = 0;
+
+    void setBounds(double bestMaxLoad) {
+        tauMax = parameters.Q / (parameters.rho * bestMaxLoad);
+        tauMin = maxMinParameters.tauRatio * tauMax;
+    }
+
+    int selectNextServer(const std::vector<double>& pheromoneRow, const std::vector<double>& loads, double taskLoad,
+                         std::vector<double>& probabilities) {
+        int numServers = servers.size();
+
+        // Calculate selection probabilities
+        double totalProbability = 0.0;
+        int bestServer = 0;
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            double taskTime = taskLoad / servers[serverId].getCapability();
+            double heuristic = 1.0 / (std::pow(loads[serverId] + taskTime, parameters.beta));
+            // Cells untouched since tauMax last dropped are clamped on read
+            double pheromone = std::clamp(pheromoneRow[serverId], tauMin, tauMax);
+            probabilities[serverId] = std::pow(pheromone, parameters.alpha) * heuristic;
+            totalProbability += probabilities[serverId];
+            if (probabilities[serverId] > probabilities[bestServer]) {
+                bestServer = serverId;
+            }
+        }
+
+        // Exploit the best server with probability q0
+        std::uniform_real_distribution<> dis(0.0, 1.0);
+        if (dis(gen) < maxMinParameters.q0) {
+            return bestServer;
+        }
+
+        // Roulette wheel selection
+        double selection = dis(gen) * totalProbability;
+        double cumulativeProbability = 0.0;
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            cumulativeProbability += probabilities[serverId];
+            if (cumulativeProbability >= selection) {
+                return serverId;
+            }
+        }
+
+        // If no server is selected, return the last server
+        return numServers - 1;
+    }
+};
+
+// Helper function to generate the workload of one seed: task loads and server capabilities
+void generateWorkload(uint64_t seed, int numTasks, int numServers, std::vector<double>& taskLoads,
+                      std::vector<int>& capabilities) {
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<> loadDis(1.0, 10.0);
+    std::uniform_int_distribution<> capabilityDis(1, 100);
+    taskLoads.resize(numTasks);
+    for (int i = 0; i < numTasks; ++i) {
+        taskLoads[i] = loadDis(gen);
+    }
+    capabilities.resize(numServers);
+    for (int i = 0; i < numServers; ++i) {
+        capabilities[i] = capabilityDis(gen);
+    }
+}
+
+// Convergence of one run: makespan ratio after each iteration and the total execution time
+struct Convergence {
+    std::vector<double> makespanRatios; // Best makespan over the capability-proportional lower bound
+    double duration;                    // Microseconds
+};
+
+// Helper function to run one algorithm on a workload and record its convergence
+template <typename LoadBalancingAlgorithm, typename... Args>
+Convergence runConvergence(const std::vector<double>& taskLoads, const std::vector<int>& capabilities, Args... args) {
+    std::vector<Server> servers;
+    double totalCapability = 0.0;
+    for (int i = 0; i < int(capabilities.size()); ++i) {
+        servers.push_back(Server(i, capabilities[i]));
+        totalCapability += capabilities[i];
+    }
+    double totalLoad = 0.0;
+    for (double taskLoad : taskLoads) {
+        totalLoad += taskLoad;
+    }
+
+    LoadBalancingAlgorithm algorithm(servers, args...);
+    auto startTime = std::chrono::steady_clock::now();
+    algorithm.balanceLoad(taskLoads);
+    auto endTime = std::chrono::steady_clock::now();
+
+    Convergence convergence;
+    for (double maxLoad : algorithm.getHistory()) {
+        convergence.makespanRatios.push_back(maxLoad / (totalLoad / totalCapability));
+    }
+    convergence.duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+    return convergence;
+}
+
+// Helper function to find the first iteration (1-based) reaching a makespan ratio, if any
+std::optional<int> iterationsToQuality(const Convergence& convergence, double targetRatio) {
+    for (int iteration = 0; iteration < int(convergence.makespanRatios.size()); ++iteration) {
+        if (convergence.makespanRatios[iteration] <= targetRatio) {
+            return iteration + 1;
+        }
+    }
+    return std::nullopt;
+}
+
+// Helper function to format a mean over the seeds that reached the target, with how many did
+std::string formatMeanIterations(double totalIterations, int numReached, int numSeeds) {
+    if (numReached == 0) {
+        return "not reached";
+    }
+    std::ostringstream mean;
+    mean << std::fixed << std::setprecision(1) << totalIterations / numReached << " (" << numReached << "/"
+         << numSeeds << ")";
+    return mean.str();
+}
+
+int main() {
+    const int NUM_TASKS = 500;
+    const int NUM_SERVERS = 50;
+    const int NUM_ITERATIONS = 100;
+    const std::vector<uint64_t> SEEDS = {1, 2, 3, 4, 5};
+    const std::vector<int> CHECKPOINTS = {1, 10, 25, 50, 100};
+
+    AntColonyParameters parameters;
+    parameters.numIterations = NUM_ITERATIONS;
+    MaxMinAntSystemParameters maxMinParameters;
+
+    std::cout << std::setw(8) << "Seed" << std::setw(24) << "Algorithm";
+    for (int checkpoint : CHECKPOINTS) {
+        std::cout << std::setw(10) << ("it " + std::to_string(checkpoint));
+    }
+    std::cout << std::setw(20) << "Iters to ACO@100" << std::setw(18) << "Time/Iter (μs)" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    // Seeds that never reach the target are left out of the means and counted separately
+    double totalClassicIterations = 0.0;
+    double totalMaxMinIterations = 0.0;
+    int classicReached = 0;
+    int maxMinReached = 0;
+    double totalClassicTime = 0.0;
+    double totalMaxMinTime = 0.0;
+    for (uint64_t seed : SEEDS) {
+        std::vector<double> taskLoads;
+        std::vector<int> capabilities;
+        generateWorkload(seed, NUM_TASKS, NUM_SERVERS, taskLoads, capabilities);
+
+        Convergence classic =
+            runConvergence<AntColonyOptimizationLoadBalancing>(taskLoads, capabilities, parameters, seed);
+        Convergence maxMin = runConvergence<MaxMinAntSystemLoadBalancing>(taskLoads, capabilities, parameters,
+                                                                          maxMinParameters, seed);
+
+        // Quality target: what the classic ACO reaches after all its iterations
+        double targetRatio = classic.makespanRatios.back();
+        std::optional<int> classicIterations = iterationsToQuality(classic, targetRatio);
+        std::optional<int> maxMinIterations = iterationsToQuality(maxMin, targetRatio);
+        if (classicIterations) {
+            totalClassicIterations += *classicIterations;
+            ++classicReached;
+        }
+        if (maxMinIterations) {
+            totalMaxMinIterations += *maxMinIterations;
+            ++maxMinReached;
+        }
+        totalClassicTime += classic.duration;
+        totalMaxMinTime += maxMin.duration;
+
+        for (const auto& [name, convergence, iterations] :
+             {std::tuple{"ACO", &classic, classicIterations}, std::tuple{"MAX-MIN ACS", &maxMin, maxMinIterations}}) {
+            std::cout << std::setw(8) << seed << std::setw(24) << name;
+            for (int checkpoint : CHECKPOINTS) {
+                std::cout << std::setw(10) << convergence->makespanRatios[checkpoint - 1];
+            }
+            std::cout << std::setw(20) << (iterations ? std::to_string(*iterations) : "not reached") << std::setw(18) << std::setprecision(1)
+                      << convergence->duration / NUM_ITERATIONS << std::setprecision(3) << std::endl;
+        }
+    }
+
+    std::cout << std::endl;
+    std::cout << std::setw(32) << "Mean Iterations to Quality" << std::setw(12) << "ACO" << std::setw(12)
+              << formatMeanIterations(totalClassicIterations, classicReached, SEEDS.size()) << std::setw(16)
+              << "MAX-MIN ACS" << std::setw(12) << formatMeanIterations(totalMaxMinIterations, maxMinReached, SEEDS.size())
+              << std::endl;
+    std::cout << std::setw(32) << "Mean Time per Iteration (μs)" << std::setw(12) << "ACO" << std::setw(12)
+              << std::setprecision(1) << totalClassicTime / SEEDS.size() / NUM_ITERATIONS << std::setw(16)
+              << "MAX-MIN ACS" << std::setw(12) << totalMaxMinTime / SEEDS.size() / NUM_ITERATIONS << std::endl;
+
+    return 0;
+}
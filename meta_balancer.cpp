@@ -0,0 +1,426 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <fmt/format.h>
+
+// Server class: queued work drains at the server capability per unit of time
+class Server {
+public:
+    Server(int id, int capability) : id(id), capability(capability), load(0) {}
+
+    void addLoad(double taskLoad) {
+        load += taskLoad;
+    }
+
+    void update(double elapsed) {
+        load = std::max(0.0, load - capability * elapsed);
+    }
+
+    double getLoad() const {
+        return load;
+    }
+
+    // Time needed to drain the queued work
+    double getRelativeLoad() const {
+        return load / capability;
+    }
+
+    int getId() const {
+        return id;
+    }
+
+    int getCapability() const {
+        return capability;
+    }
+
+private:
+    int id;
+    int capability;
+    double load;
+};
+
+// Load balancing policy interface used by the meta-balancer. Policies keep no derived view of the
+// servers, so the meta-balancer can switch between them without rebuilding anything.
+class LoadBalancingPolicy {
+public:
+    virtual ~LoadBalancingPolicy() = default;
+    virtual std::string getName() const = 0;
+    virtual int selectServer(const std::vector<Server>& servers) = 0;
+};
+
+// Round-Robin policy
+class RoundRobinPolicy : public LoadBalancingPolicy {
+public:
+    std::string getName() const override {
+        return "Round-Robin";
+    }
+
+    int selectServer(const std::vector<Server>& servers) override {
+        int selected = currentServer;
+        currentServer = (currentServer + 1) % servers.size();
+        return selected;
+    }
+
+private:
+    int currentServer = 0;
+};
+
+// Power-of-two-choices policy
+class PowerOfTwoChoicesPolicy : public LoadBalancingPolicy {
+public:
+    PowerOfTwoChoicesPolicy() : gen(std::random_device{}()) {}
+
+    std::string getName() const override {
+        return "Power of Two Choices";
+    }
+
+    int selectServer(const std::vector<Server>& servers) override {
+        std::uniform_int_distribution<> dis(0, servers.size() - 1);
+        int first = dis(gen);
+        int second = dis(gen);
+        return servers[second].getRelativeLoad() < servers[first].getRelativeLoad() ? second : first;
+    }
+
+private:
+    std::mt19937 gen;
+};
+
+// Active Clustering policy (least relative load over every server)
+class ActiveClusteringPolicy : public LoadBalancingPolicy {
+public:
+    std::string getName() const override {
+        return "Active Clustering";
+    }
+
+    int selectServer(const std::vector<Server>& servers) override {
+        double minLoad = servers[0].getRelativeLoad();
+        int minLoadServer = 0;
+        for (int serverId = 1; serverId < int(servers.size()); ++serverId) {
+            if (servers[serverId].getRelativeLoad() < minLoad) {
+                minLoad = servers[serverId].getRelativeLoad();
+                minLoadServer = serverId;
+            }
+        }
+        return minLoadServer;
+    }
+};
+
+// Sliding window mean over the last size observations
+class SlidingWindow {
+public:
+    SlidingWindow(int size) : size(size), sum(0) {}
+
+    void add(double value) {
+        values.push_back(value);
+        sum += value;
+        if (int(values.size()) > size) {
+            sum -= values.front();
+            values.pop_front();
+        }
+    }
+
+    void clear() {
+        values.clear();
+        sum = 0;
+    }
+
+    bool isFull() const {
+        return int(values.size()) == size;
+    }
+
+    double getMean() const {
+        return values.empty() ? 0.0 : sum / values.size();
+    }
+
+private:
+    int size;
+    double sum;
+    std::deque<double> values;
+};
+
+// Meta-balancer: registered policies are ordered from cheapest to best balancing. Over a sliding
+// window it escalates to the next policy when imbalance stays above the upper threshold and steps
+// back to a cheaper one when imbalance stays below the lower threshold or decisions exceed the
+// latency budget. A switch needs a full window of evidence gathered under the active policy, and a
+// policy that was demoted for exceeding the budget is not escalated to again, which together with
+// the gap between thresholds keeps it from oscillating.
+class MetaLoadBalancing {
+public:
+    struct Thresholds {
+        double upperImbalance = 1.0;   // Mean wait that triggers escalation
+        double lowerImbalance = 0.1;   // Mean wait that allows de-escalation
+        double latencyBudget = 5000.0; // Mean decision latency (ns) above which to de-escalate
+        int window = 20;              // Ticks of evidence needed before a switch
+    };
+
+    MetaLoadBalancing(std::vector<std::unique_ptr<LoadBalancingPolicy>> policies, Thresholds thresholds)
+        : policies(std::move(policies)), thresholds(thresholds), activePolicy(0), numSwitches(0),
+          imbalanceWindow(thresholds.window), latencyWindow(thresholds.window),
+          overBudget(this->policies.size(), false) {}
+
+    int selectServer(const std::vector<Server>& servers) {
+        return policies[activePolicy]->selectServer(servers);
+    }
+
+    // Called once per tick with the imbalance seen by that tick's arrivals, measured as their mean
+    // wait (drain time of the chosen server), and the mean decision latency
+    void observe(double imbalance, double decisionLatency) {
+        imbalanceWindow.add(imbalance);
+        latencyWindow.add(decisionLatency);
+        if (!imbalanceWindow.isFull()) {
+            return;
+        }
+
+        int next = activePolicy;
+        if (latencyWindow.getMean() > thresholds.latencyBudget && activePolicy > 0) {
+            overBudget[activePolicy] = true;
+            next = activePolicy - 1;
+        } else if (imbalanceWindow.getMean() > thresholds.upperImbalance && activePolicy + 1 < int(policies.size()) &&
+                   !overBudget[activePolicy + 1]) {
+            next = activePolicy + 1;
+        } else if (imbalanceWindow.getMean() < thresholds.lowerImbalance && activePolicy > 0) {
+            next = activePolicy - 1;
+        }
+
+        if (next != activePolicy) {
+            activePolicy = next;
+            ++numSwitches;
+            imbalanceWindow.clear();
+            latencyWindow.clear();
+        }
+    }
+
+    int getActivePolicy() const {
+        return activePolicy;
+    }
+
+    int getNumSwitches() const {
+        return numSwitches;
+    }
+
+private:
+    std::vector<std::unique_ptr<LoadBalancingPolicy>> policies;
+    Thresholds thresholds;
+    int activePolicy;
+    int numSwitches;
+    SlidingWindow imbalanceWindow;
+    SlidingWindow latencyWindow;
+    std::vector<bool> overBudget;
+};
+
+// Adapter that runs one fixed policy through the same interface as the meta-balancer
+class FixedLoadBalancing {
+public:
+    FixedLoadBalancing(std::unique_ptr<LoadBalancingPolicy> policy) : policy(std::move(policy)) {}
+
+    int selectServer(const std::vector<Server>& servers) {
+        return policy->selectServer(servers);
+    }
+
+    void observe(double, double) {}
+
+    int getActivePolicy() const {
+        return 0;
+    }
+
+private:
+    std::unique_ptr<LoadBalancingPolicy> policy;
+};
+
+// Workload phase: offered load as a fraction of pool capability, held for a number of ticks
+struct Phase {
+    std::string name;
+    double offeredLoad;
+    int numTicks;
+};
+
+// Per-phase results of one run
+struct PhaseResult {
+    double meanWait = 0;       // Mean drain time of the chosen server when a task arrives
+    double decisionLatency = 0; // Mean decision latency in nanoseconds
+    std::vector<int> ticksPerPolicy;
+};
+
+// Load Balancer class: a tick-driven simulation in which servers drain between ticks
+template <typename LoadBalancingAlgorithm>
+class LoadBalancer {
+public:
+    LoadBalancer(const std::vector<int>& capabilities, LoadBalancingAlgorithm algorithm)
+        : algorithm(std::move(algorithm)), gen(std::random_device{}()) {
+        int numServers = capabilities.size();
+        // Initialize servers
+        for (int i = 0; i < numServers; ++i) {
+            servers.push_back(Server(i, capabilities[i]));
+        }
+    }
+
+    std::vector<PhaseResult> run(const std::vector<Phase>& phases, int numPolicies) {
+        double totalCapability = 0.0;
+        for (const auto& server : servers) {
+            totalCapability += server.getCapability();
+        }
+        std::uniform_real_distribution<> taskDis(1.0, 10.0);
+        const double meanTaskLoad = 5.5;
+
+        std::vector<PhaseResult> results;
+        for (const auto& phase : phases) {
+            PhaseResult result;
+            result.ticksPerPolicy.assign(numPolicies, 0);
+            std::poisson_distribution<> arrivalDis(phase.offeredLoad * totalCapability / meanTaskLoad);
+            long long numTasks = 0;
+            double totalWait = 0.0;
+            double totalLatency = 0.0;
+
+            for (int tick = 0; tick < phase.numTicks; ++tick) {
+                for (auto& server : servers) {
+                    server.update(1.0);
+                }
+
+                int numArrivals = arrivalDis(gen);
+                std::vector<double> taskLoads(numArrivals);
+                for (auto& taskLoad : taskLoads) {
+                    taskLoad = taskDis(gen);
+                }
+
+                // Only the selectServer calls are timed; every interval carries the same clock
+                // read overhead, so policies stay comparable
+                double tickWait = 0.0;
+                std::chrono::steady_clock::duration decisionTime{0};
+                for (double taskLoad : taskLoads) {
+                    auto startTime = std::chrono::steady_clock::now();
+                    int serverId = algorithm.selectServer(servers);
+                    decisionTime += std::chrono::steady_clock::now() - startTime;
+
+                    Server& server = servers[serverId];
+                    tickWait += server.getRelativeLoad();
+                    server.addLoad(taskLoad);
+                }
+                double latency =
+                    numArrivals ? std::chrono::duration<double, std::nano>(decisionTime).count() / numArrivals : 0;
+
+                ++result.ticksPerPolicy[algorithm.getActivePolicy()];
+                algorithm.observe(numArrivals ? tickWait / numArrivals : 0, latency);
+                numTasks += numArrivals;
+                totalWait += tickWait;
+                totalLatency += latency * numArrivals;
+            }
+
+            result.meanWait = totalWait / numTasks;
+            result.decisionLatency = totalLatency / numTasks;
+            results.push_back(result);
+        }
+        return results;
+    }
+
+    const LoadBalancingAlgorithm& getAlgorithm() const {
+        return algorithm;
+    }
+
+private:
+    std::vector<Server> servers;
+    LoadBalancingAlgorithm algorithm;
+    std::mt19937 gen;
+};
+
+// Helper function to generate random capabilities for servers
+std::vector<int> generateRandomCapabilities(int numServers, int minCapability, int maxCapability) {
+    std::vector<int> capabilities(numServers);
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> dis(minCapability, maxCapability);
+    for (int i = 0; i < numServers; ++i) {
+        capabilities[i] = dis(gen);
+    }
+    return capabilities;
+}
+
+// Helper function to register the policies, cheapest first
+std::vector<std::unique_ptr<LoadBalancingPolicy>> makePolicies() {
+    std::vector<std::unique_ptr<LoadBalancingPolicy>> policies;
+    policies.push_back(std::make_unique<RoundRobinPolicy>());
+    policies.push_back(std::make_unique<PowerOfTwoChoicesPolicy>());
+    policies.push_back(std::make_unique<ActiveClusteringPolicy>());
+    return policies;
+}
+
+// Helper function to print the table
+void printTable(const std::vector<std::string>& algorithms, const std::vector<std::vector<PhaseResult>>& results,
+                const std::vector<Phase>& phases) {
+    std::cout << std::setw(24) << "Load Balancing Algorithm";
+    for (const auto& phase : phases) {
+        std::cout << std::setw(24) << phase.name;
+    }
+    std::cout << std::endl;
+
+    std::cout << std::setw(24) << "";
+    for (size_t i = 0; i < phases.size(); ++i) {
+        std::cout << std::setw(12) << "Mean Wait" << std::setw(12) << "ns/Task";
+    }
+    std::cout << std::endl;
+
+    std::cout << std::fixed;
+    for (size_t i = 0; i < algorithms.size(); ++i) {
+        std::cout << std::setw(24) << algorithms[i];
+        for (const auto& result : results[i]) {
+            std::cout << std::setw(12) << std::setprecision(3) << result.meanWait << std::setw(12)
+                      << std::setprecision(1) << result.decisionLatency;
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main() {
+    const int NUM_SERVERS = 500;
+    const int MIN_CAPABILITY = 4;
+    const int MAX_CAPABILITY = 8;
+    const std::vector<Phase> PHASES = {
+        {"Light (0.3)", 0.3, 1000}, {"Heavy (0.95)", 0.95, 1000}, {"Moderate (0.7)", 0.7, 1000}, {"Light (0.3)", 0.3, 1000}};
+
+    std::vector<int> capabilities = generateRandomCapabilities(NUM_SERVERS, MIN_CAPABILITY, MAX_CAPABILITY);
+
+    std::vector<std::string> algorithms;
+    std::vector<std::vector<PhaseResult>> results;
+    for (auto& policy : makePolicies()) {
+        algorithms.push_back(policy->getName());
+        LoadBalancer<FixedLoadBalancing> balancer(capabilities, FixedLoadBalancing(std::move(policy)));
+        results.push_back(balancer.run(PHASES, 1));
+    }
+
+    std::vector<std::unique_ptr<LoadBalancingPolicy>> policies = makePolicies();
+    std::vector<std::string> policyNames;
+    for (const auto& policy : policies) {
+        policyNames.push_back(policy->getName());
+    }
+    LoadBalancer<MetaLoadBalancing> metaBalancer(
+        capabilities, MetaLoadBalancing(std::move(policies), MetaLoadBalancing::Thresholds{}));
+    algorithms.push_back("Meta-Balancer");
+    results.push_back(metaBalancer.run(PHASES, policyNames.size()));
+
+    printTable(algorithms, results, PHASES);
+    std::cout << std::endl;
+
+    // Where the meta-balancer spent each phase
+    std::cout << std::setw(24) << "Meta-Balancer Ticks";
+    for (const auto& phase : PHASES) {
+        std::cout << std::setw(24) << phase.name;
+    }
+    std::cout << std::endl;
+    for (size_t policy = 0; policy < policyNames.size(); ++policy) {
+        std::cout << std::setw(24) << policyNames[policy];
+        for (const auto& result : results.back()) {
+            std::cout << std::setw(24) << result.ticksPerPolicy[policy];
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::setw(24) << "Switches" << std::setw(24) << metaBalancer.getAlgorithm().getNumSwitches()
+              << std::endl;
+
+    return 0;
+}
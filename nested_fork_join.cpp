@@ -0,0 +1,140 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <fmt/format.h>
+#include "work_stealing_pool.h"
+
+// Longest-processing-time-first placement with the sort done by nested fork-join: every level of
+// the merge sort forks its left half as a job of a TaskGroup and sorts the right half itself, so
+// groups wait inside jobs down to the cutoff. A pool that blocked its workers in wait() would
+// deadlock here as soon as the recursion is deeper than the number of threads.
+
+// Helper function to generate random task loads
+std::vector<double> generateRandomTaskLoads(int numTasks, uint64_t seed) {
+    std::vector<double> taskLoads(numTasks);
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<> dis(1.0, 10.0);
+    for (auto& taskLoad : taskLoads) {
+        taskLoad = dis(gen);
+    }
+    return taskLoads;
+}
+
+// Helper function to generate random capabilities for servers
+std::vector<int> generateRandomCapabilities(int numServers, int minCapability, int maxCapability, uint64_t seed) {
+    std::vector<int> capabilities(numServers);
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<> dis(minCapability, maxCapability);
+    for (auto& capability : capabilities) {
+        capability = dis(gen);
+    }
+    return capabilities;
+}
+
+// Sorts loads in decreasing order; buffer is scratch space of the same size. Returns the depth of
+// the deepest nested group below this call.
+int parallelSort(WorkStealingPool& pool, std::span<double> loads, std::span<double> buffer, size_t cutoff) {
+    if (loads.size() <= cutoff) {
+        std::sort(loads.begin(), loads.end(), std::greater<>());
+        return 0;
+    }
+    size_t middle = loads.size() / 2;
+    int leftDepth = 0;
+    int rightDepth = 0;
+    {
+        WorkStealingPool::TaskGroup group(pool);
+        group.run([&] { leftDepth = parallelSort(pool, loads.first(middle), buffer.first(middle), cutoff); });
+        rightDepth = parallelSort(pool, loads.subspan(middle), buffer.subspan(middle), cutoff);
+        group.wait();
+    }
+    std::merge(loads.begin(), loads.begin() + middle, loads.begin() + middle, loads.end(), buffer.begin(),
+               std::greater<>());
+    std::copy(buffer.begin(), buffer.end(), loads.begin());
+    return std::max(leftDepth, rightDepth) + 1;
+}
+
+// Helper function to place sorted task loads, each on the server that becomes free first (the LPT
+// rule); returns the makespan
+double placeLongestFirst(const std::vector<double>& sortedLoads, const std::vector<int>& capabilities) {
+    typedef std::pair<double, int> Finish; // Finish time, server
+    std::priority_queue<Finish, std::vector<Finish>, std::greater<>> servers;
+    for (int serverId = 0; serverId < int(capabilities.size()); ++serverId) {
+        servers.push({0.0, serverId});
+    }
+    double makespan = 0.0;
+    for (double taskLoad : sortedLoads) {
+        auto [finish, serverId] = servers.top();
+        servers.pop();
+        finish += taskLoad / capabilities[serverId];
+        makespan = std::max(makespan, finish);
+        servers.push({finish, serverId});
+    }
+    return makespan;
+}
+
+int main(int argc, char** argv) {
+    const int NUM_TASKS = 4000000;
+    const int NUM_SERVERS = 1000;
+    const size_t CUTOFF = 4096;
+    const uint64_t SEED = 42;
+    int maxThreads = argc > 1 ? std::stoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<double> taskLoads = generateRandomTaskLoads(NUM_TASKS, SEED);
+    std::vector<int> capabilities = generateRandomCapabilities(NUM_SERVERS, 1, 100, SEED);
+
+    std::vector<double> expected = taskLoads;
+    auto startTime = std::chrono::steady_clock::now();
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    auto endTime = std::chrono::steady_clock::now();
+    double sequentialDuration = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    double makespan = placeLongestFirst(expected, capabilities);
+
+    std::cout << std::setw(28) << "Tasks" << std::setw(20) << NUM_TASKS << std::endl;
+    std::cout << std::setw(28) << "LPT Makespan" << std::setw(20) << std::fixed << std::setprecision(2) << makespan
+              << std::endl;
+    std::cout << std::setw(28) << "std::sort (ms)" << std::setw(20) << sequentialDuration << std::endl;
+    std::cout << std::endl;
+
+    // One thread is the case a blocking wait() cannot survive: every nested group has to be joined
+    // by the thread that forked it
+    std::vector<int> numThreads = {1};
+    for (int threads = 2; threads <= maxThreads; threads *= 2) {
+        numThreads.push_back(threads);
+    }
+    if (numThreads.back() != maxThreads) {
+        numThreads.push_back(maxThreads);
+    }
+
+    std::cout << std::setw(8) << "Threads" << std::setw(16) << "Nesting Depth" << std::setw(16) << "Sort (ms)"
+              << std::setw(12) << "Speedup" << std::setw(16) << "LPT Makespan" << std::endl;
+    for (int threads : numThreads) {
+        WorkStealingPool pool(threads);
+        std::vector<double> loads = taskLoads;
+        std::vector<double> buffer(loads.size());
+        startTime = std::chrono::steady_clock::now();
+        int depth = parallelSort(pool, loads, buffer, CUTOFF);
+        endTime = std::chrono::steady_clock::now();
+        if (loads != expected) {
+            throw std::runtime_error("Nested fork-join sort differs from std::sort");
+        }
+        double duration = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        std::cout << std::setw(8) << threads << std::setw(16) << depth << std::setw(16) << duration << std::setw(12)
+                  << sequentialDuration / duration << std::setw(16) << placeLongestFirst(loads, capabilities)
+                  << std::endl;
+        if (threads == numThreads.back()) {
+            std::cout << std::endl;
+            pool.printUtilization();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,459 @@
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <fmt/format.h>
+
+// Server class
+class Server {
+public:
+    Server(int id, int capability) : id(id), capability(capability), load(0) {}
+
+    void addLoad(double taskLoad) {
+        load += taskLoad;
+    }
+
+    void update(double elapsed) {
+        load = std::max(0.0, load - capability * elapsed);
+    }
+
+    double getLoad() const {
+        return load;
+    }
+
+    int getId() const {
+        return id;
+    }
+
+    int getCapability() const {
+        return capability;
+    }
+
+private:
+    int id;
+    int capability;
+    double load;
+};
+
+// NUMA node and the CPUs that belong to it
+struct NumaNode {
+    int id;
+    std::vector<int> cpus;
+};
+
+// NUMA topology read from /sys/devices/system/node. Hosts without that directory (or non-Linux
+// hosts) are described as a single node holding every CPU.
+class NumaTopology {
+public:
+    static NumaTopology discover() {
+        NumaTopology topology;
+        std::ifstream online("/sys/devices/system/node/online");
+        std::string nodeList;
+        if (online >> nodeList) {
+            for (int nodeId : parseList(nodeList)) {
+                std::ifstream cpuList("/sys/devices/system/node/node" + std::to_string(nodeId) + "/cpulist");
+                std::string cpus;
+                if (cpuList >> cpus) {
+                    topology.nodes.push_back({nodeId, parseList(cpus)});
+                }
+            }
+        }
+        // Memory-only nodes have no CPU to run a worker on
+        topology.nodes.erase(std::remove_if(topology.nodes.begin(), topology.nodes.end(),
+                                            [](const NumaNode& node) { return node.cpus.empty(); }),
+                             topology.nodes.end());
+        if (topology.nodes.empty()) {
+            NumaNode node{0, {}};
+            for (int cpu = 0; cpu < int(std::max(1u, std::thread::hardware_concurrency())); ++cpu) {
+                node.cpus.push_back(cpu);
+            }
+            topology.nodes.push_back(node);
+        }
+        return topology;
+    }
+
+    // Parses a sysfs list such as "0-3,8-11"
+    static std::vector<int> parseList(const std::string& list) {
+        std::vector<int> values;
+        std::stringstream stream(list);
+        std::string range;
+        while (std::getline(stream, range, ',')) {
+            if (range.empty()) continue;
+            size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int value = first; value <= last; ++value) {
+                values.push_back(value);
+            }
+        }
+        return values;
+    }
+
+    const std::vector<NumaNode>& getNodes() const {
+        return nodes;
+    }
+
+    // Node holding the CPU, or -1 when the topology does not list it
+    int getNodeOfCpu(int cpu) const {
+        for (const auto& node : nodes) {
+            if (std::find(node.cpus.begin(), node.cpus.end(), cpu) != node.cpus.end()) {
+                return node.id;
+            }
+        }
+        return -1;
+    }
+
+private:
+    std::vector<NumaNode> nodes;
+};
+
+// Helper function to pin the calling thread to one CPU; returns false if the host refuses
+bool pinCurrentThread(int cpu) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+}
+
+// Helper function to add how many pages of a buffer live on each NUMA node to counts, using
+// move_pages in query mode (no target nodes). counts has numNodes + 1 entries; the last one
+// collects pages whose node is unknown, which is every page when the query is not supported.
+void countPageNodes(const void* data, size_t bytes, std::vector<size_t>& counts) {
+    int numNodes = counts.size() - 1;
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    uintptr_t first = uintptr_t(data) / pageSize * pageSize;
+    std::vector<void*> pages;
+    for (uintptr_t page = first; page < uintptr_t(data) + bytes; page += pageSize) {
+        pages.push_back((void*)page);
+    }
+#ifdef SYS_move_pages
+    std::vector<int> status(pages.size());
+    if (syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) == 0) {
+        for (int node : status) {
+            ++counts[node >= 0 && node < numNodes ? node : numNodes];
+        }
+        return;
+    }
+#endif
+    counts[numNodes] += pages.size();
+}
+
+// Helper function to read one counter (e.g. "local_node", "other_node") from a node's numastat;
+// returns 0 when it is unavailable
+long long readNumaStat(int nodeId, const std::string& counter) {
+    std::ifstream numastat("/sys/devices/system/node/node" + std::to_string(nodeId) + "/numastat");
+    std::string name;
+    long long value;
+    while (numastat >> name >> value) {
+        if (name == counter) {
+            return value;
+        }
+    }
+    return 0;
+}
+
+// One shard of the simulation: its servers, the queue of tasks waiting to be placed and the
+// pheromone trails (one row per queued task) used to place them. Everything a worker touches in
+// its inner loop lives here.
+struct Shard {
+    std::vector<Server> servers;
+    std::vector<double> taskQueue;
+    std::vector<double> pheromones; // taskQueue.size() x servers.size(), row-major
+
+    Shard(const std::vector<int>& capabilities, int queueLength)
+        : taskQueue(queueLength, 0.0), pheromones(size_t(queueLength) * capabilities.size(), 1.0) {
+        for (int i = 0; i < int(capabilities.size()); ++i) {
+            servers.push_back(Server(i, capabilities[i]));
+        }
+    }
+
+    size_t getBytes() const {
+        return servers.size() * sizeof(Server) + taskQueue.size() * sizeof(double) +
+               pheromones.size() * sizeof(double);
+    }
+
+    // Pages of every shard buffer per NUMA node, with pages of unknown placement in the last entry
+    std::vector<size_t> getPageNodes(int numNodes) const {
+        std::vector<size_t> counts(numNodes + 1, 0);
+        countPageNodes(servers.data(), servers.size() * sizeof(Server), counts);
+        countPageNodes(taskQueue.data(), taskQueue.size() * sizeof(double), counts);
+        countPageNodes(pheromones.data(), pheromones.size() * sizeof(double), counts);
+        return counts;
+    }
+};
+
+// Per-worker counters: placement throughput, the shard's page census and the bytes streamed from
+// the shard. The local / remote byte split is an estimate: the streamed bytes scaled by the share of
+// pages with a known node that are on, or off, the worker's node. A pinned worker's node is the one
+// it was pinned to; an unpinned worker's is the node sched_getcpu saw it on in every epoch, or -1
+// when it ran on more than one. Pages of unknown placement, and every page of a worker whose node
+// is -1, are counted as unknown and left out of both.
+struct WorkerStats {
+    int cpu = -1;
+    int nodeId = -1;
+    bool pinned = false;
+    double duration = 0; // Seconds
+    long long placements = 0;
+    size_t localPages = 0;
+    size_t remotePages = 0;
+    size_t unknownPages = 0;
+    double streamedBytes = 0;
+
+    double getEstimatedLocalBytes() const {
+        return localPages + remotePages > 0 ? streamedBytes * localPages / (localPages + remotePages) : 0.0;
+    }
+
+    double getEstimatedRemoteBytes() const {
+        return localPages + remotePages > 0 ? streamedBytes * remotePages / (localPages + remotePages) : 0.0;
+    }
+};
+
+// Sharded simulation: every worker owns one shard and runs epochs of queue refill, pheromone-guided
+// placement and server drain on it. When numaAware is set, each worker pins itself to a CPU of its
+// node before allocating its shard, so first touch puts the shard's pages on that node. Otherwise
+// the calling thread allocates every shard up front and workers run wherever the scheduler puts
+// them, which is the layout a plain std::vector<Server> setup produces.
+class ShardedSimulation {
+public:
+    ShardedSimulation(const NumaTopology& topology, int numWorkers, const std::vector<int>& capabilities,
+                      int queueLength, bool numaAware)
+        : topology(topology), numWorkers(numWorkers), capabilities(capabilities), queueLength(queueLength),
+          numaAware(numaAware), shards(numWorkers), stats(numWorkers) {
+        const auto& nodes = topology.getNodes();
+        for (int worker = 0; worker < numWorkers; ++worker) {
+            // Workers are spread round-robin over nodes, then over the CPUs of each node
+            const NumaNode& node = nodes[worker % nodes.size()];
+            stats[worker].nodeId = node.id;
+            stats[worker].cpu = node.cpus[(worker / nodes.size()) % node.cpus.size()];
+        }
+        if (!numaAware) {
+            for (int worker = 0; worker < numWorkers; ++worker) {
+                shards[worker] = std::make_unique<Shard>(capabilities, queueLength);
+            }
+        }
+    }
+
+    void run(int numEpochs, uint64_t seed) {
+        std::vector<std::thread> workers;
+        for (int worker = 0; worker < numWorkers; ++worker) {
+            workers.emplace_back([this, worker, numEpochs, seed] { runWorker(worker, numEpochs, seed + worker); });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    const std::vector<WorkerStats>& getStats() const {
+        return stats;
+    }
+
+private:
+    const NumaTopology& topology;
+    int numWorkers;
+    std::vector<int> capabilities;
+    int queueLength;
+    bool numaAware;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<WorkerStats> stats;
+
+    void runWorker(int worker, int numEpochs, uint64_t seed) {
+        WorkerStats& workerStats = stats[worker];
+        if (numaAware) {
+            workerStats.pinned = pinCurrentThread(workerStats.cpu);
+            shards[worker] = std::make_unique<Shard>(capabilities, queueLength);
+        }
+        Shard& shard = *shards[worker];
+        // An unpinned worker's node is only known once it has been seen running there
+        int observedNode = -2;
+
+        std::mt19937_64 gen(seed);
+        std::uniform_real_distribution<> loadDis(1.0, 10.0);
+        int numServers = shard.servers.size();
+        double totalCapability = 0.0;
+        for (const auto& server : shard.servers) {
+            totalCapability += server.getCapability();
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        for (int epoch = 0; epoch < numEpochs; ++epoch) {
+            if (!workerStats.pinned) {
+                int cpu = sched_getcpu();
+                int nodeId = cpu < 0 ? -1 : topology.getNodeOfCpu(cpu);
+                observedNode = observedNode == -2 || observedNode == nodeId ? nodeId : -1;
+            }
+
+            // Refill the queue
+            double queuedLoad = 0.0;
+            for (auto& taskLoad : shard.taskQueue) {
+                taskLoad = loadDis(gen);
+                queuedLoad += taskLoad;
+            }
+
+            // Place each task on the server with the best pheromone / tentative finish time
+            // weight, then reinforce the chosen cell
+            for (int taskId = 0; taskId < queueLength; ++taskId) {
+                double* row = shard.pheromones.data() + size_t(taskId) * numServers;
+                int bestServer = 0;
+                double bestWeight = -1.0;
+                for (int serverId = 0; serverId < numServers; ++serverId) {
+                    const Server& server = shard.servers[serverId];
+                    double weight = row[serverId] * server.getCapability() /
+                                    (server.getLoad() + shard.taskQueue[taskId]);
+                    if (weight > bestWeight) {
+                        bestWeight = weight;
+                        bestServer = serverId;
+                    }
+                }
+                shard.servers[bestServer].addLoad(shard.taskQueue[taskId]);
+                row[bestServer] = 0.9 * row[bestServer] + 0.1;
+            }
+
+            // Drain the work placed this epoch
+            for (auto& server : shard.servers) {
+                server.update(queuedLoad / totalCapability);
+            }
+        }
+        auto endTime = std::chrono::steady_clock::now();
+
+        workerStats.duration = std::chrono::duration<double>(endTime - startTime).count();
+        workerStats.placements = (long long)numEpochs * queueLength;
+        workerStats.streamedBytes = double(numEpochs) * shard.getBytes();
+        if (!workerStats.pinned) {
+            workerStats.nodeId = observedNode == -2 ? -1 : observedNode;
+        }
+
+        // Census of the shard's pages: on the worker's node, on another node, or unknown
+        int numNodes = topology.getNodes().back().id + 1;
+        std::vector<size_t> pageNodes = shard.getPageNodes(numNodes);
+        workerStats.unknownPages = pageNodes[numNodes];
+        for (int nodeId = 0; nodeId < numNodes; ++nodeId) {
+            if (workerStats.nodeId < 0) {
+                workerStats.unknownPages += pageNodes[nodeId];
+            } else {
+                (nodeId == workerStats.nodeId ? workerStats.localPages : workerStats.remotePages) += pageNodes[nodeId];
+            }
+        }
+    }
+};
+
+// Helper function to generate random capabilities for servers
+std::vector<int> generateRandomCapabilities(int numServers, int minCapability, int maxCapability) {
+    std::vector<int> capabilities(numServers);
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> dis(minCapability, maxCapability);
+    for (int i = 0; i < numServers; ++i) {
+        capabilities[i] = dis(gen);
+    }
+    return capabilities;
+}
+
+// Helper function to format an estimated bandwidth, or "unknown" when no page placement was known
+std::string formatEstimatedBandwidth(double bytes, double duration, bool known) {
+    if (!known) {
+        return "unknown";
+    }
+    std::ostringstream bandwidth;
+    bandwidth << std::fixed << std::setprecision(3) << bytes / duration / 1e9;
+    return bandwidth.str();
+}
+
+// Helper function to format a page census as local / remote / unknown page counts
+std::string formatPages(size_t localPages, size_t remotePages, size_t unknownPages) {
+    return std::to_string(localPages) + "/" + std::to_string(remotePages) + "/" + std::to_string(unknownPages);
+}
+
+// Helper function to run one layout and print its per-worker counters and totals
+void runLayout(const std::string& name, const NumaTopology& topology, int numWorkers,
+               const std::vector<int>& capabilities, int queueLength, int numEpochs, bool numaAware) {
+    std::vector<long long> localBefore, otherBefore;
+    for (const auto& node : topology.getNodes()) {
+        localBefore.push_back(readNumaStat(node.id, "local_node"));
+        otherBefore.push_back(readNumaStat(node.id, "other_node"));
+    }
+
+    ShardedSimulation simulation(topology, numWorkers, capabilities, queueLength, numaAware);
+    auto startTime = std::chrono::steady_clock::now();
+    simulation.run(numEpochs, 42);
+    auto endTime = std::chrono::steady_clock::now();
+
+    std::cout << name << std::endl;
+    // Bandwidths are estimates from the page census, not hardware counters
+    std::cout << std::setw(8) << "Worker" << std::setw(8) << "Node" << std::setw(8) << "CPU" << std::setw(8)
+              << "Pinned" << std::setw(20) << "Placements/s (M)" << std::setw(24) << "Pages Local/Remote/?"
+              << std::setw(22) << "Est. Local (GB/s)" << std::setw(22) << "Est. Remote (GB/s)" << std::endl;
+    long long totalPlacements = 0;
+    size_t totalLocalPages = 0;
+    size_t totalRemotePages = 0;
+    size_t totalUnknownPages = 0;
+    double totalLocal = 0.0;
+    double totalRemote = 0.0;
+    for (int worker = 0; worker < numWorkers; ++worker) {
+        const WorkerStats& stats = simulation.getStats()[worker];
+        bool known = stats.localPages + stats.remotePages > 0;
+        std::cout << std::setw(8) << worker << std::setw(8) << (stats.nodeId < 0 ? "?" : std::to_string(stats.nodeId))
+                  << std::setw(8)
+                  << (stats.pinned ? std::to_string(stats.cpu) : "-") << std::setw(8) << (stats.pinned ? "yes" : "no")
+                  << std::setw(20) << stats.placements / stats.duration / 1e6 << std::setw(24)
+                  << formatPages(stats.localPages, stats.remotePages, stats.unknownPages) << std::setw(22)
+                  << formatEstimatedBandwidth(stats.getEstimatedLocalBytes(), stats.duration, known) << std::setw(22)
+                  << formatEstimatedBandwidth(stats.getEstimatedRemoteBytes(), stats.duration, known) << std::endl;
+        totalPlacements += stats.placements;
+        totalLocalPages += stats.localPages;
+        totalRemotePages += stats.remotePages;
+        totalUnknownPages += stats.unknownPages;
+        totalLocal += stats.getEstimatedLocalBytes();
+        totalRemote += stats.getEstimatedRemoteBytes();
+    }
+    double duration = std::chrono::duration<double>(endTime - startTime).count();
+    bool known = totalLocalPages + totalRemotePages > 0;
+    std::cout << std::setw(32) << "Total" << std::setw(20) << totalPlacements / duration / 1e6 << std::setw(24)
+              << formatPages(totalLocalPages, totalRemotePages, totalUnknownPages) << std::setw(22)
+              << formatEstimatedBandwidth(totalLocal, duration, known) << std::setw(22)
+              << formatEstimatedBandwidth(totalRemote, duration, known) << std::endl;
+
+    // Kernel page allocation counters over the run: pages placed on the node of the allocating CPU
+    // versus pages that had to come from another node
+    for (size_t i = 0; i < topology.getNodes().size(); ++i) {
+        int nodeId = topology.getNodes()[i].id;
+        std::cout << std::setw(32) << ("numastat node" + std::to_string(nodeId)) << std::setw(20)
+                  << ("local " + std::to_string(readNumaStat(nodeId, "local_node") - localBefore[i])) << std::setw(18)
+                  << ("other " + std::to_string(readNumaStat(nodeId, "other_node") - otherBefore[i])) << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const int SERVERS_PER_SHARD = 256;
+    const int QUEUE_LENGTH = 1024;
+    const int NUM_EPOCHS = 200;
+
+    NumaTopology topology = NumaTopology::discover();
+    int numCpus = 0;
+    for (const auto& node : topology.getNodes()) {
+        numCpus += node.cpus.size();
+        std::cout << "node" << node.id << ": " << node.cpus.size() << " CPUs" << std::endl;
+    }
+    int numWorkers = argc > 1 ? std::stoi(argv[1]) : numCpus;
+    std::cout << "workers: " << numWorkers << std::endl << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    std::vector<int> capabilities = generateRandomCapabilities(SERVERS_PER_SHARD, 1, 10);
+    runLayout("Allocated by main thread, unpinned", topology, numWorkers, capabilities, QUEUE_LENGTH, NUM_EPOCHS,
+              false);
+    runLayout("First touch by pinned owner", topology, numWorkers, capabilities, QUEUE_LENGTH, NUM_EPOCHS, true);
+
+    return 0;
+}
@@ -1,69 +1,390 @@
 #include <iostream>
 #include <vector>
+#include <queue>
+#include <functional>
 #include <random>
 #include <cmath>
 #include <iomanip>
+#include <algorithm>
+#include <set>
+#include <concepts>
+#include <stdexcept>
 #include <fmt/format.h>
+#include "profiling.h"
+#include "fast_range.h"
 
-// Server class
+// Server class: c parallel service slots of equal speed (an M/M/c station) in front of a bounded queue
 class Server {
 public:
-    Server(int id, int capability) : id(id), capability(capability), load(0) {}
+    Server(int id, int slots, double slotSpeed, int queueLimit)
+        : id(id), slots(slots), slotSpeed(slotSpeed), queueLimit(queueLimit), time(0), queuedLoad(0), completedLoad(0) {
+        reset();
+    }
 
-    void addLoad(int time) {
-        loads.push_back(time);
-        total_load ++;
+    // Queues a task at the current time on the earliest free slot; returns false when the queue is full
+    bool addLoad(double taskLoad) {
+        if (isFull()) {
+            return false;
+        }
+        double startTime = std::max(time, slotFreeTimes.top());
+        slotFreeTimes.pop();
+        double completionTime = startTime + taskLoad / slotSpeed;
+        slotFreeTimes.push(completionTime);
+        loads.push({completionTime, taskLoad});
+        queuedLoad += taskLoad;
+        return true;
     }
 
     void reset() {
-        total_load = 0;
-        loads.clear();
+        time = 0;
+        queuedLoad = 0;
+        completedLoad = 0;
+        loads = {};
+        slotFreeTimes = {};
+        for (int slot = 0; slot < slots; ++slot) {
+            slotFreeTimes.push(0);
+        }
     }
 
+    // Tasks in the system, in service or waiting
     int getLoad() const {
         return int(std::ssize(loads));
     }
 
+    // Tasks beyond the busy slots; negative when slots are idle, so JSQ prefers servers with free slots
+    int getBacklog() const {
+        return getLoad() - slots;
+    }
+
+    int getBusySlots() const {
+        return std::min(getLoad(), slots);
+    }
+
+    bool isFull() const {
+        return getBacklog() >= queueLimit;
+    }
+
+    int getQueueLimit() const {
+        return queueLimit;
+    }
+
     int getId() const {
         return id;
     }
 
-    int getCapability() const {
-        return capability;
+    int getSlots() const {
+        return slots;
+    }
+
+    double getCapability() const {
+        return slots * slotSpeed;
+    }
+
+    // Work of every task in the system, finished or not
+    double getQueuedLoad() const {
+        return queuedLoad;
+    }
+
+    double getCompletedLoad() const {
+        return completedLoad;
     }
 
-    int update(int time) {
+    // Advances the server clock and retires every task finished by then; returns the number retired
+    int update(double currentTime) {
+        time = currentTime;
+        int completed = 0;
         while (!loads.empty()) {
-            if (loads.front() > capability * time) break;
-            loads.erase(loads.begin());
+            if (loads.top().completionTime > time) break;
+            queuedLoad -= loads.top().taskLoad;
+            completedLoad += loads.top().taskLoad;
+            loads.pop();
+            ++completed;
         }
+        return completed;
     }
 
 private:
+    struct QueuedTask {
+        double completionTime;
+        double taskLoad;
+
+        bool operator>(const QueuedTask& other) const {
+            return completionTime > other.completionTime;
+        }
+    };
+
     int id;
-    int capability;
-    double load;
-    int total_load;
-    std::vector<int> loads;
+    int slots;
+    double slotSpeed;
+    int queueLimit;
+    double time;
+    double queuedLoad;
+    double completedLoad;
+    // Min-heaps: tasks ordered by completion time and slots ordered by the time they become free
+    std::priority_queue<QueuedTask, std::vector<QueuedTask>, std::greater<>> loads;
+    std::priority_queue<double, std::vector<double>, std::greater<>> slotFreeTimes;
+};
+
+// Admission control policies applied when the pool is overloaded
+enum class AdmissionPolicy {
+    Reject,   // Drop a task whose selected server queue is full
+    Shed,     // Drop tasks at dispatch once the pool's queued tasks pass a threshold
+    Redirect  // Retry a full server's task on other servers before dropping it
+};
+
+// Admission control: the single path through which algorithms place tasks on servers
+class AdmissionControl {
+public:
+    AdmissionControl(AdmissionPolicy policy, double shedThreshold = 0.9, int maxRetries = 3)
+        : policy(policy), shedThreshold(shedThreshold), maxRetries(maxRetries), gen(std::random_device{}()),
+          offered(0), admitted(0), dropped(0), shed(0), retried(0), queued(0) {}
+
+    // Places a task on the selected server, applying the policy when the pool is past the shed
+    // threshold or the server's queue is full. Shedding is decided per task against the running queued
+    // total, so it sees every task placed earlier in the same tick.
+    bool dispatch(std::vector<Server>& servers, int serverId, double taskLoad) {
+        PROFILE_ZONE("admission.dispatch");
+        ++offered;
+        if (policy == AdmissionPolicy::Shed &&
+            queued >= shedThreshold * servers[serverId].getQueueLimit() * servers.size()) {
+            ++shed;
+            return false;
+        }
+        if (place(servers[serverId], taskLoad)) {
+            return true;
+        }
+        if (policy == AdmissionPolicy::Redirect) {
+            std::uniform_int_distribution<> dis(0, servers.size() - 1);
+            for (int retry = 0; retry < maxRetries; ++retry) {
+                ++retried;
+                PROFILE_COUNT("admission.retries", 1);
+                if (place(servers[dis(gen)], taskLoad)) {
+                    return true;
+                }
+            }
+        }
+        ++dropped;
+        return false;
+    }
+
+    // Advances a server's clock, keeping the queued total in step; returns the number of tasks retired
+    int update(Server& server, double currentTime) {
+        int previousQueued = std::max(0, server.getBacklog());
+        int completed = server.update(currentTime);
+        queued += std::max(0, server.getBacklog()) - previousQueued;
+        return completed;
+    }
+
+    long long getOffered() const {
+        return offered;
+    }
+
+    long long getAdmitted() const {
+        return admitted;
+    }
+
+    long long getDropped() const {
+        return dropped + shed;
+    }
+
+    long long getRetried() const {
+        return retried;
+    }
+
+    // Called with the id of every server that accepts a task
+    void setLoadListener(std::function<void(int)> listener) {
+        loadListener = std::move(listener);
+    }
+
+private:
+    AdmissionPolicy policy;
+    double shedThreshold;
+    int maxRetries;
+    std::mt19937 gen;
+    long long offered;
+    long long admitted;
+    long long dropped;
+    long long shed;
+    long long retried;
+    long long queued; // Tasks waiting beyond the busy slots, summed over the pool
+    std::function<void(int)> loadListener;
+
+    bool place(Server& server, double taskLoad) {
+        int previousQueued = std::max(0, server.getBacklog());
+        if (!server.addLoad(taskLoad)) {
+            return false;
+        }
+        queued += std::max(0, server.getBacklog()) - previousQueued;
+        ++admitted;
+        notifyLoadChanged(server.getId());
+        return true;
+    }
+
+    void notifyLoadChanged(int serverId) {
+        if (loadListener) {
+            loadListener(serverId);
+        }
+    }
+};
+
+// Least-loaded index: keeps servers ordered by a load key so that the least-loaded server is found
+// without scanning the pool. The general version is an ordered set with O(log n) updates and ties
+// broken by the lowest server id.
+template <typename Key>
+class LeastLoadedIndex {
+public:
+    LeastLoadedIndex(const std::vector<Key>& initialKeys, Key minKey, Key maxKey) : keys(initialKeys) {
+        for (int serverId = 0; serverId < int(keys.size()); ++serverId) {
+            ordered.insert({keys[serverId], serverId});
+        }
+    }
+
+    void update(int serverId, Key key) {
+        ordered.erase({keys[serverId], serverId});
+        keys[serverId] = key;
+        ordered.insert({key, serverId});
+    }
+
+    int getLeastLoaded() {
+        return ordered.begin()->second;
+    }
+
+private:
+    std::vector<Key> keys;
+    std::set<std::pair<Key, int>> ordered;
 };
 
+// Bucket queue for integral keys in [minKey, maxKey]: one intrusive doubly linked list of servers
+// per key plus the lowest possibly non-empty bucket. Updates are O(1), and finding the minimum only
+// walks up past buckets emptied since the last query, which is O(1) amortized when loads move by
+// one task at a time. Ties go to the server that has held the key longest.
+template <std::integral Key>
+class LeastLoadedIndex<Key> {
+public:
+    LeastLoadedIndex(const std::vector<Key>& initialKeys, Key minKey, Key maxKey)
+        : minKey(minKey), keys(initialKeys), heads(maxKey - minKey + 1, -1), tails(maxKey - minKey + 1, -1),
+          next(keys.size(), -1), previous(keys.size(), -1), minBucket(maxKey - minKey + 1) {
+        for (int serverId = 0; serverId < int(keys.size()); ++serverId) {
+            link(serverId);
+        }
+    }
+
+    void update(int serverId, Key key) {
+        if (keys[serverId] == key) {
+            return;
+        }
+        unlink(serverId);
+        keys[serverId] = key;
+        link(serverId);
+    }
+
+    int getLeastLoaded() {
+        while (heads[minBucket] < 0) {
+            ++minBucket;
+        }
+        return heads[minBucket];
+    }
+
+private:
+    Key minKey;
+    std::vector<Key> keys;
+    std::vector<int> heads;
+    std::vector<int> tails;
+    std::vector<int> next;
+    std::vector<int> previous;
+    size_t minBucket;
+
+    size_t getBucket(Key key) const {
+        if (key < minKey || size_t(key - minKey) >= heads.size()) {
+            throw std::invalid_argument("Load key outside the range of the bucket queue");
+        }
+        return size_t(key - minKey);
+    }
+
+    // Appends a server to the tail of its key's list
+    void link(int serverId) {
+        size_t bucket = getBucket(keys[serverId]);
+        previous[serverId] = tails[bucket];
+        next[serverId] = -1;
+        if (tails[bucket] >= 0) {
+            next[tails[bucket]] = serverId;
+        } else {
+            heads[bucket] = serverId;
+        }
+        tails[bucket] = serverId;
+        minBucket = std::min(minBucket, bucket);
+    }
+
+    void unlink(int serverId) {
+        size_t bucket = getBucket(keys[serverId]);
+        if (previous[serverId] >= 0) {
+            next[previous[serverId]] = next[serverId];
+        } else {
+            heads[bucket] = next[serverId];
+        }
+        if (next[serverId] >= 0) {
+            previous[next[serverId]] = previous[serverId];
+        } else {
+            tails[bucket] = previous[serverId];
+        }
+    }
+};
+
+// Least-loaded index over server backlogs; a bucket queue as long as backlogs are integral
+typedef LeastLoadedIndex<decltype(std::declval<const Server&>().getBacklog())> BacklogIndex;
+
+// Helper function to build a backlog index over the servers: backlogs range from minus the largest
+// slot count (all slots idle) up to the largest queue limit
+BacklogIndex makeBacklogIndex(const std::vector<Server>& servers) {
+    std::vector<int> backlogs;
+    int minBacklog = 0;
+    int maxBacklog = 0;
+    for (const auto& server : servers) {
+        backlogs.push_back(server.getBacklog());
+        minBacklog = std::min(minBacklog, -server.getSlots());
+        maxBacklog = std::max(maxBacklog, server.getQueueLimit());
+    }
+    return BacklogIndex(backlogs, minBacklog, maxBacklog);
+}
+
 // Load Balancer class
 template <typename LoadBalancingAlgorithm>
 class LoadBalancer {
 public:
-    LoadBalancer(const std::vector<int>& capabilities) {
-        int numServers = capabilities.size();
-        // Initialize servers
-        for (int i = 0; i < numServers; ++i) {
-            servers.push_back(Server(i, capabilities[i]));
+    // Each unit of capability is one service slot of the given speed
+    LoadBalancer(const std::vector<int>& capabilities, double slotSpeed, int queueLimit, AdmissionPolicy policy)
+        : simulatedTime(0), servers(createServers(capabilities, slotSpeed, queueLimit)),
+          admission(policy), algorithm(servers, admission) {
+        // Algorithms that index server loads hear about every change
+        if constexpr (requires { algorithm.onLoadChanged(0); }) {
+            admission.setLoadListener([this](int serverId) { algorithm.onLoadChanged(serverId); });
         }
     }
 
     void run(const std::vector<double>& taskLoads) {
-        LoadBalancingAlgorithm algorithm(servers);
+        PROFILE_ZONE("balanceLoad");
         algorithm.balanceLoad(taskLoads);
     }
 
+    // Feeds arrivalRate tasks per unit of time, letting servers drain their queues between ticks
+    void simulate(const std::vector<double>& taskLoads, int arrivalRate) {
+        for (size_t first = 0; first < taskLoads.size(); first += arrivalRate) {
+            simulatedTime += 1.0;
+            {
+                PROFILE_ZONE("server.update");
+                for (auto& server : servers) {
+                    if (admission.update(server, simulatedTime) > 0) {
+                        if constexpr (requires { algorithm.onLoadChanged(0); }) {
+                            algorithm.onLoadChanged(server.getId());
+                        }
+                    }
+                }
+            }
+            size_t last = std::min(taskLoads.size(), first + arrivalRate);
+            run(std::vector<double>(taskLoads.begin() + first, taskLoads.begin() + last));
+        }
+    }
+
     double getTotalLoad() const {
         double totalLoad = 0.0;
         for (const auto& server : servers) {
@@ -72,186 +393,256 @@ public:
         return totalLoad;
     }
 
-    double getThroughput(double simulatedTime) const {
+    // Work completed per unit of time, relative to the total capability of the pool
+    double getGoodput() const {
         double totalCapability = 0.0;
+        double completedLoad = 0.0;
         for (const auto& server : servers) {
             totalCapability += server.getCapability();
+            completedLoad += server.getCompletedLoad();
         }
-        double totalLoad = getTotalLoad();
-        return totalLoad / simulatedTime / totalCapability;
+        return completedLoad / simulatedTime / totalCapability;
+    }
+
+    const AdmissionControl& getAdmission() const {
+        return admission;
     }
 
 private:
+    double simulatedTime;
     std::vector<Server> servers;
+    AdmissionControl admission;
+    LoadBalancingAlgorithm algorithm;
+
+    // Servers exist before the algorithm is constructed, so algorithms can index them up front
+    static std::vector<Server> createServers(const std::vector<int>& capabilities, double slotSpeed, int queueLimit) {
+        std::vector<Server> servers;
+        for (int i = 0; i < int(capabilities.size()); ++i) {
+            servers.push_back(Server(i, capabilities[i], slotSpeed, queueLimit));
+        }
+        return servers;
+    }
 };
 
 // Random algorithm
 class RandomLoadBalancing {
 public:
-    RandomLoadBalancing(const std::vector<Server>& servers) : servers(servers) {}
+    RandomLoadBalancing(std::vector<Server>& servers, AdmissionControl& admission)
+        : servers(servers), admission(admission), indices(servers.size(), std::random_device{}()) {}
 
     void balanceLoad(const std::vector<double>& taskLoads) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(0, servers.size() - 1);
-
         for (const auto& taskLoad : taskLoads) {
-            int randomServer = dis(gen);
-            servers[randomServer].addLoad(taskLoad);
+            int randomServer;
+            {
+                PROFILE_ZONE("random.rng");
+                randomServer = indices.next();
+            }
+            admission.dispatch(servers, randomServer, taskLoad);
         }
     }
 
 private:
-    std::vector<Server> servers;
+    std::vector<Server>& servers;
+    AdmissionControl& admission;
+    fast_range::IndexStream indices;
 };
 
 // Round-Robin algorithm
 class RoundRobinLoadBalancing {
 public:
-    RoundRobinLoadBalancing(const std::vector<Server>& servers) : servers(servers), currentServer(0) {}
+    RoundRobinLoadBalancing(std::vector<Server>& servers, AdmissionControl& admission)
+        : servers(servers), admission(admission), cursor(servers.size()) {}
 
     void balanceLoad(const std::vector<double>& taskLoads) {
         for (const auto& taskLoad : taskLoads) {
-            servers[currentServer].addLoad(taskLoad);
-            currentServer = (currentServer + 1) % servers.size();
+            admission.dispatch(servers, cursor.next(), taskLoad);
         }
     }
 
 private:
-    std::vector<Server> servers;
-    int currentServer;
+    std::vector<Server>& servers;
+    AdmissionControl& admission;
+    fast_range::RoundRobinCursor cursor;
 };
 
 // Weighted Round-Robin algorithm
 class WeightedRoundRobinLoadBalancing {
 public:
-    WeightedRoundRobinLoadBalancing(const std::vector<Server>& servers) : servers(servers), currentServer(0) {}
+    WeightedRoundRobinLoadBalancing(std::vector<Server>& servers, AdmissionControl& admission)
+        : servers(servers), admission(admission), currentServer(0), backlogs(makeBacklogIndex(servers)) {}
 
     void balanceLoad(const std::vector<double>& taskLoads) {
         for (const auto& taskLoad : taskLoads) {
-            servers[currentServer].addLoad(taskLoad);
+            admission.dispatch(servers, currentServer, taskLoad);
             updateCurrentServer();
         }
     }
 
+    void onLoadChanged(int serverId) {
+        PROFILE_ZONE("backlogIndex.update");
+        backlogs.update(serverId, servers[serverId].getBacklog());
+    }
+
 private:
-    std::vector<Server> servers;
+    std::vector<Server>& servers;
+    AdmissionControl& admission;
     int currentServer;
+    BacklogIndex backlogs;
 
     void updateCurrentServer() {
-        double minLoad = servers[0].getLoad();
-        int minLoadServer = servers[0].getId();
-        for (const auto& server : servers) {
-            if (server.getLoad() < minLoad) {
-                minLoad = server.getLoad();
-                minLoadServer = server.getId();
-            }
-        }
-        currentServer = minLoadServer;
+        PROFILE_ZONE("weightedRoundRobin.select");
+        currentServer = backlogs.getLeastLoaded();
     }
 };
 
 // Active Clustering algorithm
 class ActiveClusteringLoadBalancing {
 public:
-    ActiveClusteringLoadBalancing(const std::vector<Server>& servers) : servers(servers) {}
+    ActiveClusteringLoadBalancing(std::vector<Server>& servers, AdmissionControl& admission)
+        : servers(servers), admission(admission), backlogs(makeBacklogIndex(servers)) {}
 
     void balanceLoad(const std::vector<double>& taskLoads) {
         for (const auto& taskLoad : taskLoads) {
-            // Find the server with the minimum load
-            double minLoad = servers[0].getLoad();
-            int minLoadServer = servers[0].getId();
-            for (const auto& server : servers) {
-                if (server.getLoad() < minLoad) {
-                    minLoad = server.getLoad();
-                    minLoadServer = server.getId();
-                }
+            int minLoadServer;
+            {
+                PROFILE_ZONE("activeClustering.select");
+                minLoadServer = backlogs.getLeastLoaded();
             }
 
             // Assign the task to the server with the minimum load
-            servers[minLoadServer].addLoad(taskLoad);
+            admission.dispatch(servers, minLoadServer, taskLoad);
         }
     }
 
+    void onLoadChanged(int serverId) {
+        PROFILE_ZONE("backlogIndex.update");
+        backlogs.update(serverId, servers[serverId].getBacklog());
+    }
+
 private:
-    std::vector<Server> servers;
+    std::vector<Server>& servers;
+    AdmissionControl& admission;
+    BacklogIndex backlogs;
+};
+
+// Ant Colony Optimization parameters
+struct AntColonyParameters {
+    double alpha = 1.0;      // Pheromone importance factor
+    double beta = 2.0;       // Heuristic information importance factor
+    double rho = 0.5;        // Pheromone evaporation rate
+    double Q = 1.0;          // Pheromone deposit quantity
+    int numIterations = 100;
 };
 
 // Ant Colony Optimization algorithm
 class AntColonyOptimizationLoadBalancing {
 public:
-    AntColonyOptimizationLoadBalancing(const std::vector<Server>& servers) : servers(servers) {}
+    AntColonyOptimizationLoadBalancing(std::vector<Server>& servers, AdmissionControl& admission,
+                                       AntColonyParameters parameters = {})
+        : servers(servers), admission(admission), parameters(parameters), gen(std::random_device{}()) {}
 
     void balanceLoad(const std::vector<double>& taskLoads) {
         int numTasks = taskLoads.size();
         int numServers = servers.size();
 
         // Ant Colony Optimization parameters
-        const double alpha = 1.0; // Pheromone importance factor
-        const double beta = 2.0;  // Heuristic information importance factor
-        const double rho = 0.5;   // Pheromone evaporation rate
-        const double Q = 1.0;     // Pheromone deposit quantity
+        const double alpha = parameters.alpha;
+        const double beta = parameters.beta;
+        const double rho = parameters.rho;
+        const double Q = parameters.Q;
 
         // Initialize pheromone trails
         std::vector<std::vector<double>> pheromones(numTasks, std::vector<double>(numServers, 1.0));
 
+        // Ants work on tentative loads (queued work per unit of capability) so that the real queues
+        // only see the final assignment
+        std::vector<double> initialLoads(numServers);
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            initialLoads[serverId] = servers[serverId].getQueuedLoad() / servers[serverId].getCapability();
+        }
+        std::vector<int> assignment(numTasks);
+        std::vector<int> bestAssignment(numTasks);
+        double bestMaxLoad = INFINITY;
+
         // Perform Ant Colony Optimization
-        const int numIterations = 100;
-        for (int iteration = 0; iteration < numIterations; ++iteration) {
+        for (int iteration = 0; iteration < parameters.numIterations; ++iteration) {
+            std::vector<double> loads = initialLoads;
+
             // Move ants
             for (int taskId = 0; taskId < numTasks; ++taskId) {
-                int currentServer = selectNextServer(taskId, pheromones, taskLoads, alpha, beta);
-                servers[currentServer].addLoad(taskLoads[taskId]);
+                int currentServer = selectNextServer(taskId, pheromones, loads, taskLoads, alpha, beta);
+                loads[currentServer] += taskLoads[taskId] / servers[currentServer].getCapability();
+                assignment[taskId] = currentServer;
+            }
+
+            {
+                PROFILE_ZONE("antColony.bookkeeping");
+                double maxLoad = *std::max_element(loads.begin(), loads.end());
+                if (maxLoad < bestMaxLoad) {
+                    bestMaxLoad = maxLoad;
+                    bestAssignment = assignment;
+                }
             }
 
             // Update pheromones
-            updatePheromones(pheromones, taskLoads, rho, Q);
+            updatePheromones(pheromones, loads, taskLoads, rho, Q);
+        }
 
-            // Reset server loads
-            for (auto& server : servers) {
-                server.resetLoad();
-            }
+        for (int taskId = 0; taskId < numTasks; ++taskId) {
+            admission.dispatch(servers, bestAssignment[taskId], taskLoads[taskId]);
         }
     }
 
 private:
-    std::vector<Server> servers;
+    std::vector<Server>& servers;
+    AdmissionControl& admission;
+    AntColonyParameters parameters;
+    std::mt19937 gen;
 
-    int selectNextServer(int taskId, const std::vector<std::vector<double>>& pheromones,
+    int selectNextServer(int taskId, const std::vector<std::vector<double>>& pheromones, const std::vector<double>& loads,
                          const std::vector<double>& taskLoads, double alpha, double beta) {
+        PROFILE_ZONE("antColony.selectNextServer");
         int numServers = servers.size();
+        PROFILE_COUNT("antColony.probabilitiesComputed", numServers);
 
         // Calculate selection probabilities
         std::vector<double> probabilities(numServers, 0.0);
         double totalProbability = 0.0;
         for (int serverId = 0; serverId < numServers; ++serverId) {
             double pheromone = pheromones[taskId][serverId];
-            double heuristic = 1.0 / (std::pow(servers[serverId].getLoad() + taskLoads[taskId], beta));
+            double taskTime = taskLoads[taskId] / servers[serverId].getCapability();
+            double heuristic = 1.0 / (std::pow(loads[serverId] + taskTime, beta));
             probabilities[serverId] = std::pow(pheromone, alpha) * heuristic;
             totalProbability += probabilities[serverId];
         }
 
         // Roulette wheel selection
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::uniform_real_distribution<> dis(0.0, totalProbability);
-        double selection = dis(gen);
+        double selection;
+        {
+            PROFILE_ZONE("antColony.rng");
+            selection = dis(gen);
+        }
         double cumulativeProbability = 0.0;
         for (int serverId = 0; serverId < numServers; ++serverId) {
             cumulativeProbability += probabilities[serverId];
             if (cumulativeProbability >= selection) {
+                PROFILE_COUNT("antColony.serversScanned", serverId + 1);
                 return serverId;
             }
         }
+        PROFILE_COUNT("antColony.serversScanned", numServers);
 
         // If no server is selected, return the last server
         return numServers - 1;
     }
 
-    void updatePheromones(std::vector<std::vector<double>>& pheromones,
+    void updatePheromones(std::vector<std::vector<double>>& pheromones, const std::vector<double>& loads,
                           const std::vector<double>& taskLoads, double rho, double Q) {
+        PROFILE_ZONE("antColony.updatePheromones");
         int numTasks = taskLoads.size();
         int numServers = servers.size();
+        PROFILE_COUNT("antColony.pheromonesUpdated", numTasks * numServers);
 
         // Evaporate pheromones
         for (int taskId = 0; taskId < numTasks; ++taskId) {
@@ -263,7 +654,8 @@ private:
         // Deposit pheromones based on server loads
         for (int taskId = 0; taskId < numTasks; ++taskId) {
             for (int serverId = 0; serverId < numServers; ++serverId) {
-                double deltaPheromone = Q / (servers[serverId].getLoad() + taskLoads[taskId]);
+                double taskTime = taskLoads[taskId] / servers[serverId].getCapability();
+                double deltaPheromone = Q / (loads[serverId] + taskTime);
                 pheromones[taskId][serverId] += deltaPheromone;
             }
         }
@@ -294,72 +686,97 @@ std::vector<int> generateRandomCapabilities(int numServers, int minCapability, i
     return capabilities;
 }
 
+// Helper function to run one overload experiment and record goodput, drop rate and retries per
+// offered task; profiled builds also print the run's zones and counters under the given title
+template <typename LoadBalancingAlgorithm>
+void runOverload(const std::string& title, const std::vector<int>& capabilities, const std::vector<double>& taskLoads,
+                 int arrivalRate, double slotSpeed, int queueLimit, AdmissionPolicy policy, double& goodput,
+                 double& dropRate, double& retryRate) {
+    PROFILE_RESET();
+    LoadBalancer<LoadBalancingAlgorithm> balancer(capabilities, slotSpeed, queueLimit, policy);
+    balancer.simulate(taskLoads, arrivalRate);
+    PROFILE_REPORT(title);
+    goodput = balancer.getGoodput();
+    dropRate = double(balancer.getAdmission().getDropped()) / balancer.getAdmission().getOffered();
+    retryRate = double(balancer.getAdmission().getRetried()) / balancer.getAdmission().getOffered();
+}
+
 // Helper function to print the table
-void printTable(const std::vector<std::vector<double>>& durations, const std::vector<double>& throughputs, const std::vector<int>& numTasks) {
-    std::cout << std::setw(20) << "Load Balancing Algorithm";
-    for (const auto& numTask : numTasks) {
-        std::cout << std::setw(20) << "Num Tasks: " << numTask;
+void printTable(const std::string& title, const std::vector<std::vector<double>>& goodputs,
+                const std::vector<std::vector<double>>& dropRates, const std::vector<std::vector<double>>& retryRates,
+                const std::vector<double>& offeredLoads) {
+    std::cout << title << std::endl;
+    std::cout << std::setw(24) << "Load Balancing Algorithm";
+    for (const auto& offeredLoad : offeredLoads) {
+        std::cout << std::setw(21) << "Offered: " << std::setw(6) << offeredLoad;
     }
-    std::cout << std::setw(20) << "Throughput (Tasks/s)" << std::endl;
+    std::cout << std::endl;
 
-    std::cout << std::setw(20) << "";
-    for (size_t i = 0; i < numTasks.size(); ++i) {
-        std::cout << std::setw(20) << "Execution Time (μs)";
+    std::cout << std::setw(24) << "";
+    for (size_t i = 0; i < offeredLoads.size(); ++i) {
+        std::cout << std::setw(14) << "Goodput" << std::setw(6) << "Drop" << std::setw(7) << "Retry";
     }
-    std::cout << std::setw(20) << "" << std::endl;
+    std::cout << std::endl;
 
     std::vector<std::string> algorithms = {"Random", "Round-Robin", "Weighted Round-Robin", "Active Clustering", "Ant Colony Optimization"};
-    for (size_t i = 0; i < durations.size(); ++i) {
-        std::cout << std::setw(20) << algorithms[i];
-        for (const auto& duration : durations[i]) {
-            std::cout << std::setw(20) << duration;
+    for (size_t i = 0; i < goodputs.size(); ++i) {
+        std::cout << std::setw(24) << algorithms[i];
+        for (size_t j = 0; j < goodputs[i].size(); ++j) {
+            std::cout << std::setw(14) << goodputs[i][j] << std::setw(6) << dropRates[i][j] << std::setw(7)
+                      << retryRates[i][j];
         }
-        std::cout << std::setw(20) << throughputs[i] << std::endl;
+        std::cout << std::endl;
     }
+    std::cout << std::endl;
 }
 
 int main() {
     const int NUM_SERVERS = 20;
     const int MIN_CAPABILITY = 1;
     const int MAX_CAPABILITY = 100;
-    const std::vector<int> NUM_TASKS = {100, 1000, 10000};
-
-    std::vector<std::vector<double>> durations(5, std::vector<double>(NUM_TASKS.size()));
-    std::vector<double> throughputs(5);
+    const int NUM_TASKS = 10000;
+    const double SLOT_SPEED = 1.0;
+    const int QUEUE_LIMIT = 32;
+    const double MEAN_TASK_LOAD = 5.5;
+    const std::vector<double> OFFERED_LOADS = {0.5, 0.8, 1.0, 1.2, 1.5, 2.0};
+    const std::vector<std::pair<std::string, AdmissionPolicy>> POLICIES = {
+        {"Reject", AdmissionPolicy::Reject}, {"Shed", AdmissionPolicy::Shed}, {"Redirect", AdmissionPolicy::Redirect}};
 
     // Generate random capabilities for servers
     std::vector<int> capabilities = generateRandomCapabilities(NUM_SERVERS, MIN_CAPABILITY, MAX_CAPABILITY);
+    double totalCapability = 0.0;
+    for (const auto& capability : capabilities) {
+        totalCapability += capability * SLOT_SPEED;
+    }
 
-    for (size_t i = 0; i < NUM_TASKS.size(); ++i) {
-        std::vector<double> taskLoads = generateRandomTaskLoads(NUM_TASKS[i]);
-
-        LoadBalancer<RandomLoadBalancing> randomBalancer(capabilities);
-        randomBalancer.run(taskLoads);
-        durations[0][i] = randomBalancer.getTotalLoad();
-        throughputs[0] = randomBalancer.getThroughput(NUM_TASKS[i]);
-
-        LoadBalancer<RoundRobinLoadBalancing> roundRobinBalancer(capabilities);
-        roundRobinBalancer.run(taskLoads);
-        durations[1][i] = roundRobinBalancer.getTotalLoad();
-        throughputs[1] = roundRobinBalancer.getThroughput(NUM_TASKS[i]);
-
-        LoadBalancer<WeightedRoundRobinLoadBalancing> weightedRoundRobinBalancer(capabilities);
-        weightedRoundRobinBalancer.run(taskLoads);
-        durations[2][i] = weightedRoundRobinBalancer.getTotalLoad();
-        throughputs[2] = weightedRoundRobinBalancer.getThroughput(NUM_TASKS[i]);
-
-        LoadBalancer<ActiveClusteringLoadBalancing> activeClusteringBalancer(capabilities);
-        activeClusteringBalancer.run(taskLoads);
-        durations[3][i] = activeClusteringBalancer.getTotalLoad();
-        throughputs[3] = activeClusteringBalancer.getThroughput(NUM_TASKS[i]);
+    std::vector<double> taskLoads = generateRandomTaskLoads(NUM_TASKS);
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& [policyName, policy] : POLICIES) {
+        std::vector<std::vector<double>> goodputs(5, std::vector<double>(OFFERED_LOADS.size()));
+        std::vector<std::vector<double>> dropRates(5, std::vector<double>(OFFERED_LOADS.size()));
+        std::vector<std::vector<double>> retryRates(5, std::vector<double>(OFFERED_LOADS.size()));
+
+        for (size_t i = 0; i < OFFERED_LOADS.size(); ++i) {
+            // Tasks per unit of time that make the offered load this fraction of the pool capability
+            int arrivalRate = std::max(1, int(std::lround(OFFERED_LOADS[i] * totalCapability / MEAN_TASK_LOAD)));
+            std::string runTitle =
+                policyName + ", offered " + std::to_string(std::lround(100 * OFFERED_LOADS[i])) + "%: ";
+
+            runOverload<RandomLoadBalancing>(runTitle + "Random", capabilities, taskLoads, arrivalRate, SLOT_SPEED, QUEUE_LIMIT, policy,
+                                             goodputs[0][i], dropRates[0][i], retryRates[0][i]);
+            runOverload<RoundRobinLoadBalancing>(runTitle + "Round-Robin", capabilities, taskLoads, arrivalRate, SLOT_SPEED, QUEUE_LIMIT, policy,
+                                                 goodputs[1][i], dropRates[1][i], retryRates[1][i]);
+            runOverload<WeightedRoundRobinLoadBalancing>(runTitle + "Weighted Round-Robin", capabilities, taskLoads, arrivalRate, SLOT_SPEED, QUEUE_LIMIT, policy,
+                                                         goodputs[2][i], dropRates[2][i], retryRates[2][i]);
+            runOverload<ActiveClusteringLoadBalancing>(runTitle + "Active Clustering", capabilities, taskLoads, arrivalRate, SLOT_SPEED, QUEUE_LIMIT, policy,
+                                                       goodputs[3][i], dropRates[3][i], retryRates[3][i]);
+            runOverload<AntColonyOptimizationLoadBalancing>(runTitle + "Ant Colony Optimization", capabilities, taskLoads, arrivalRate, SLOT_SPEED, QUEUE_LIMIT, policy,
+                                                            goodputs[4][i], dropRates[4][i], retryRates[4][i]);
+        }
 
-        LoadBalancer<AntColonyOptimizationLoadBalancing> antColonyOptimizationBalancer(capabilities);
-        antColonyOptimizationBalancer.run(taskLoads);
-        durations[4][i] = antColonyOptimizationBalancer.getTotalLoad();
-        throughputs[4] = antColonyOptimizationBalancer.getThroughput(NUM_TASKS[i]);
+        printTable("Admission policy: " + policyName, goodputs, dropRates, retryRates, OFFERED_LOADS);
     }
 
-    printTable(durations, throughputs, NUM_TASKS);
-
     return 0;
 }
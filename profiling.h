@@ -0,0 +1,296 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Scoped profiling zones and work counters for the balancers. With LOAD_BALANCING_PROFILING
+// defined, PROFILE_ZONE("name") times the rest of the enclosing scope with the TSC and
+// PROFILE_COUNT("name", amount) adds to a named counter; both accumulate in thread-local tables
+// that PROFILE_REPORT merges across threads and prints. Without it every macro expands to nothing
+// but PROFILE_REPORT's title, and the count expressions are never evaluated.
+namespace profiling {
+
+// Cycle counter: the TSC on x86, nanoseconds elsewhere
+inline uint64_t readTimestamp() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+struct ZoneStats {
+    uint64_t calls = 0;
+    uint64_t inclusiveCycles = 0; // Including nested zones
+    uint64_t exclusiveCycles = 0; // Excluding nested zones
+
+    void merge(const ZoneStats& other) {
+        calls += other.calls;
+        inclusiveCycles += other.inclusiveCycles;
+        exclusiveCycles += other.exclusiveCycles;
+    }
+};
+
+// Zone and counter names, registered once per call site; ids index the per-thread tables
+class Registry {
+public:
+    // Capacity of the per-thread tables, for zones and for counters
+    static constexpr int MAX_IDS = 128;
+
+    static Registry& get() {
+        static Registry registry;
+        return registry;
+    }
+
+    int getZoneId(const std::string& name) {
+        return getId(zoneNames, name);
+    }
+
+    int getCounterId(const std::string& name) {
+        return getId(counterNames, name);
+    }
+
+    std::vector<std::string> getZoneNames() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return zoneNames;
+    }
+
+    std::vector<std::string> getCounterNames() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return counterNames;
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::string> zoneNames;
+    std::vector<std::string> counterNames;
+
+    int getId(std::vector<std::string>& names, const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name) {
+                return i;
+            }
+        }
+        if (names.size() == MAX_IDS) {
+            throw std::runtime_error("Too many profiling zones or counters: " + name);
+        }
+        names.push_back(name);
+        return names.size() - 1;
+    }
+};
+
+class Zone;
+
+// One thread's accumulation. Threads register on first use; a thread that exits folds its
+// results into the retired totals so that a later report still sees them. The tables have a fixed
+// size and relaxed atomic entries: only the owner writes them, with a plain load and store, and
+// collect and reset may read or clear them from another thread while the owner runs. A report
+// taken while workers run therefore sees each entry whole, though entries may be from slightly
+// different moments, and a reset can lose to an update in flight on another thread.
+class ThreadProfile {
+public:
+    std::array<std::array<std::atomic<uint64_t>, 3>, Registry::MAX_IDS> zones{}; // Calls, inclusive, exclusive
+    std::array<std::atomic<uint64_t>, Registry::MAX_IDS> counters{};
+    Zone* currentZone = nullptr;
+
+    static ThreadProfile& get() {
+        static thread_local ThreadProfile profile;
+        return profile;
+    }
+
+    void addZone(int id, uint64_t inclusiveCycles, uint64_t exclusiveCycles) {
+        add(zones[id][0], 1);
+        add(zones[id][1], inclusiveCycles);
+        add(zones[id][2], exclusiveCycles);
+    }
+
+    void addCount(int id, uint64_t amount) {
+        add(counters[id], amount);
+    }
+
+    // Totals over live and exited threads
+    static void collect(std::vector<ZoneStats>& zoneTotals, std::vector<uint64_t>& counterTotals) {
+        std::lock_guard<std::mutex> lock(getMutex());
+        zoneTotals = getRetired().zones;
+        counterTotals = getRetired().counters;
+        for (ThreadProfile* profile : getLive()) {
+            merge(*profile, zoneTotals, counterTotals);
+        }
+    }
+
+    static void reset() {
+        std::lock_guard<std::mutex> lock(getMutex());
+        getRetired().zones.assign(Registry::MAX_IDS, ZoneStats{});
+        getRetired().counters.assign(Registry::MAX_IDS, 0);
+        for (ThreadProfile* profile : getLive()) {
+            for (auto& zone : profile->zones) {
+                for (auto& value : zone) {
+                    value.store(0, std::memory_order_relaxed);
+                }
+            }
+            for (auto& counter : profile->counters) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Totals {
+        std::vector<ZoneStats> zones = std::vector<ZoneStats>(Registry::MAX_IDS);
+        std::vector<uint64_t> counters = std::vector<uint64_t>(Registry::MAX_IDS);
+    };
+
+    ThreadProfile() {
+        std::lock_guard<std::mutex> lock(getMutex());
+        getLive().push_back(this);
+    }
+
+    ~ThreadProfile() {
+        std::lock_guard<std::mutex> lock(getMutex());
+        merge(*this, getRetired().zones, getRetired().counters);
+        std::erase(getLive(), this);
+    }
+
+    // Single-writer update: no read-modify-write instruction needed
+    static void add(std::atomic<uint64_t>& value, uint64_t amount) {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    static void merge(const ThreadProfile& profile, std::vector<ZoneStats>& zoneTotals,
+                      std::vector<uint64_t>& counterTotals) {
+        for (int i = 0; i < Registry::MAX_IDS; ++i) {
+            zoneTotals[i].merge({profile.zones[i][0].load(std::memory_order_relaxed),
+                                 profile.zones[i][1].load(std::memory_order_relaxed),
+                                 profile.zones[i][2].load(std::memory_order_relaxed)});
+            counterTotals[i] += profile.counters[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    static std::mutex& getMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::vector<ThreadProfile*>& getLive() {
+        static std::vector<ThreadProfile*> live;
+        return live;
+    }
+
+    static Totals& getRetired() {
+        static Totals retired;
+        return retired;
+    }
+};
+
+// RAII zone: charges its lifetime to its id and removes it from the enclosing zone's exclusive time
+class Zone {
+public:
+    explicit Zone(int id) : id(id), profile(ThreadProfile::get()), parent(profile.currentZone), childCycles(0) {
+        profile.currentZone = this;
+        start = readTimestamp();
+    }
+
+    ~Zone() {
+        uint64_t elapsed = readTimestamp() - start;
+        profile.addZone(id, elapsed, elapsed - childCycles);
+        if (parent) {
+            parent->childCycles += elapsed;
+        }
+        profile.currentZone = parent;
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    int id;
+    ThreadProfile& profile;
+    Zone* parent;
+    uint64_t childCycles;
+    uint64_t start;
+};
+
+// Timestamp ticks per second, measured once against the steady clock
+inline double getTimestampFrequency() {
+    static const double frequency = [] {
+        auto startTime = std::chrono::steady_clock::now();
+        uint64_t startTimestamp = readTimestamp();
+        while (std::chrono::steady_clock::now() - startTime < std::chrono::milliseconds(20)) {
+        }
+        uint64_t endTimestamp = readTimestamp();
+        auto endTime = std::chrono::steady_clock::now();
+        return (endTimestamp - startTimestamp) / std::chrono::duration<double>(endTime - startTime).count();
+    }();
+    return frequency;
+}
+
+inline void reset() {
+    ThreadProfile::reset();
+}
+
+// Prints every zone and counter touched since the last reset
+inline void report(std::ostream& out, const std::string& title) {
+    std::vector<ZoneStats> zones;
+    std::vector<uint64_t> counters;
+    ThreadProfile::collect(zones, counters);
+    std::vector<std::string> zoneNames = Registry::get().getZoneNames();
+    std::vector<std::string> counterNames = Registry::get().getCounterNames();
+    double cyclesPerMillisecond = getTimestampFrequency() / 1000;
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "Profile: " << title << std::endl;
+    out << std::setw(36) << "Zone" << std::setw(12) << "Calls" << std::setw(16) << "Inclusive (ms)" << std::setw(16)
+        << "Exclusive (ms)" << std::setw(16) << "Cycles/Call" << std::endl;
+    for (size_t i = 0; i < zoneNames.size(); ++i) {
+        if (zones[i].calls == 0) continue;
+        out << std::setw(36) << zoneNames[i] << std::setw(12) << zones[i].calls << std::fixed << std::setw(16)
+            << std::setprecision(3) << zones[i].inclusiveCycles / cyclesPerMillisecond << std::setw(16)
+            << zones[i].exclusiveCycles / cyclesPerMillisecond << std::setw(16) << std::setprecision(1)
+            << double(zones[i].inclusiveCycles) / zones[i].calls << std::endl;
+    }
+    for (size_t i = 0; i < counterNames.size(); ++i) {
+        if (counters[i] == 0) continue;
+        out << std::setw(36) << counterNames[i] << std::setw(12) << counters[i] << std::endl;
+    }
+    out << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace profiling
+
+#ifdef LOAD_BALANCING_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name)                                                                                          \
+    static const int PROFILE_CONCAT(profileZoneId, __LINE__) = ::profiling::Registry::get().getZoneId(name);        \
+    ::profiling::Zone PROFILE_CONCAT(profileZone, __LINE__)(PROFILE_CONCAT(profileZoneId, __LINE__))
+#define PROFILE_COUNT(name, amount)                                                                                 \
+    do {                                                                                                            \
+        static const int profileCounterId = ::profiling::Registry::get().getCounterId(name);                       \
+        ::profiling::ThreadProfile::get().addCount(profileCounterId, amount);                                       \
+    } while (false)
+#define PROFILE_RESET() ::profiling::reset()
+#define PROFILE_REPORT(title) ::profiling::report(std::cout, title)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_COUNT(name, amount) ((void)0)
+#define PROFILE_RESET() ((void)0)
+#define PROFILE_REPORT(title) ((void)(title))
+#endif
@@ -0,0 +1,651 @@
+#include <iostream>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+#include <bit>
+#include <numbers>
+#include <fmt/format.h>
+#include "work_stealing_pool.h"
+
+// KLL quantile sketch (Karnin, Lang and Liberty): a stack of compactors where level h holds items
+// of weight 2^h. A full compactor sorts itself and promotes every other item (random offset) to
+// the next level. Capacities shrink geometrically (factor 2/3) from the top level down, so memory
+// is O(k) plus a few items per level regardless of the stream length. Sketches with the same k
+// merge by concatenating levels and compacting.
+class KllSketch {
+public:
+    KllSketch(int k = 200, uint64_t seed = 1) : k(k), gen(seed), count(0), retained(0), maxRetained(0) {
+        grow();
+    }
+
+    void add(double value) {
+        if (count == 0) {
+            minValue = maxValue = value;
+        }
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+        ++count;
+        levels[0].push_back(value);
+        if (++retained >= maxRetained) {
+            compress();
+        }
+    }
+
+    void merge(const KllSketch& other) {
+        if (other.k != k) {
+            throw std::invalid_argument("cannot merge KLL sketches with different k");
+        }
+        if (other.count == 0) return;
+        while (levels.size() < other.levels.size()) {
+            grow();
+        }
+        for (size_t h = 0; h < other.levels.size(); ++h) {
+            levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+        }
+        minValue = count ? std::min(minValue, other.minValue) : other.minValue;
+        maxValue = count ? std::max(maxValue, other.maxValue) : other.maxValue;
+        count += other.count;
+        updateRetained();
+        while (retained >= maxRetained) {
+            compress();
+        }
+    }
+
+    // Value whose rank is about q * count; the rank is within getRankError() * count of q * count
+    double getQuantile(double q) const {
+        if (count == 0) return NAN;
+        if (q <= 0) return minValue;
+        if (q >= 1) return maxValue;
+        std::vector<std::pair<double, uint64_t>> weighted;
+        for (size_t h = 0; h < levels.size(); ++h) {
+            for (double value : levels[h]) {
+                weighted.push_back({value, uint64_t(1) << h});
+            }
+        }
+        std::sort(weighted.begin(), weighted.end());
+        double target = q * count;
+        uint64_t cumulative = 0;
+        for (const auto& [value, weight] : weighted) {
+            cumulative += weight;
+            if (cumulative >= target) {
+                return value;
+            }
+        }
+        return maxValue;
+    }
+
+    // Normalized rank error for a single quantile query at 99% confidence, using the empirical fit
+    // published with the DataSketches KLL implementation
+    double getRankError() const {
+        return 2.296 / std::pow(k, 0.9723);
+    }
+
+    uint64_t getCount() const {
+        return count;
+    }
+
+    size_t getRetained() const {
+        return retained;
+    }
+
+private:
+    int k;
+    std::mt19937_64 gen;
+    std::vector<std::vector<double>> levels;
+    uint64_t count;
+    size_t retained;
+    size_t maxRetained;
+    double minValue = NAN;
+    double maxValue = NAN;
+
+    size_t getCapacity(size_t h) const {
+        size_t depth = levels.size() - h - 1;
+        return std::max<size_t>(2, size_t(std::ceil(k * std::pow(2.0 / 3.0, depth))));
+    }
+
+    void grow() {
+        levels.emplace_back();
+        maxRetained = 0;
+        for (size_t h = 0; h < levels.size(); ++h) {
+            maxRetained += getCapacity(h);
+        }
+    }
+
+    void updateRetained() {
+        retained = 0;
+        for (const auto& level : levels) {
+            retained += level.size();
+        }
+    }
+
+    // Compacts the lowest full level; an odd item stays behind at its level
+    void compress() {
+        for (size_t h = 0; h < levels.size(); ++h) {
+            if (levels[h].size() < getCapacity(h)) continue;
+            if (h + 1 == levels.size()) {
+                grow();
+            }
+            std::vector<double>& level = levels[h];
+            std::sort(level.begin(), level.end());
+            double odd = NAN;
+            bool hasOdd = level.size() % 2 == 1;
+            if (hasOdd) {
+                odd = level.back();
+                level.pop_back();
+            }
+            size_t offset = gen() & 1;
+            for (size_t i = offset; i < level.size(); i += 2) {
+                levels[h + 1].push_back(level[i]);
+            }
+            level.clear();
+            if (hasOdd) {
+                level.push_back(odd);
+            }
+            break;
+        }
+        updateRetained();
+    }
+};
+
+// Merging t-digest (Dunning and Ertl): the distribution is summarized by weighted centroids whose
+// size is capped by the arcsine scale function, so centroids near q = 0 and q = 1 hold few items
+// and the rank error of a tail quantile shrinks with its distance from the end. Values are
+// buffered and merged into the centroids in sorted batches; digests merge the same way. Unlike
+// HDR it needs no value range, which makes it the fallback for tails that overflow the histogram.
+class TDigest {
+public:
+    TDigest(double compression = 200) : compression(compression), count(0) {}
+
+    void add(double value) {
+        if (count == 0) {
+            minValue = maxValue = value;
+        }
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+        ++count;
+        buffer.push_back({value, 1.0});
+        if (buffer.size() >= BUFFER_FACTOR * compression) {
+            compress();
+        }
+    }
+
+    void merge(const TDigest& other) {
+        if (other.compression != compression) {
+            throw std::invalid_argument("cannot merge t-digests with different compression");
+        }
+        if (other.count == 0) return;
+        minValue = count ? std::min(minValue, other.minValue) : other.minValue;
+        maxValue = count ? std::max(maxValue, other.maxValue) : other.maxValue;
+        count += other.count;
+        buffer.insert(buffer.end(), other.centroids.begin(), other.centroids.end());
+        buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+        compress();
+    }
+
+    // Interpolates between centroid centers, and between the extreme centroids and the min and max
+    double getQuantile(double q) const {
+        if (count == 0) return NAN;
+        if (q <= 0) return minValue;
+        if (q >= 1) return maxValue;
+        std::vector<Centroid> merged = getMerged();
+        double target = q * count;
+        double previousCenter = 0.0;
+        double previousMean = minValue;
+        double cumulative = 0.0;
+        for (const auto& centroid : merged) {
+            double center = cumulative + centroid.weight / 2;
+            if (target < center) {
+                return previousMean + (centroid.mean - previousMean) * (target - previousCenter) / (center - previousCenter);
+            }
+            cumulative += centroid.weight;
+            previousCenter = center;
+            previousMean = centroid.mean;
+        }
+        return previousMean + (maxValue - previousMean) * (target - previousCenter) / (count - previousCenter);
+    }
+
+    uint64_t getCount() const {
+        return count;
+    }
+
+    size_t getCentroids() const {
+        return getMerged().size();
+    }
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    static constexpr int BUFFER_FACTOR = 5;
+
+    double compression;
+    std::vector<Centroid> centroids;
+    std::vector<Centroid> buffer;
+    uint64_t count;
+    double minValue = NAN;
+    double maxValue = NAN;
+
+    // Arcsine scale function k(q) and its inverse: a centroid may span at most one unit of k
+    double getScale(double q) const {
+        return compression / (2 * std::numbers::pi) * std::asin(2 * q - 1);
+    }
+
+    double getQuantileOfScale(double k) const {
+        k = std::min(k, compression / 4);
+        return (std::sin(k * 2 * std::numbers::pi / compression) + 1) / 2;
+    }
+
+    std::vector<Centroid> getMerged() const {
+        std::vector<Centroid> sorted = centroids;
+        sorted.insert(sorted.end(), buffer.begin(), buffer.end());
+        std::sort(sorted.begin(), sorted.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+        std::vector<Centroid> merged;
+        double cumulative = 0.0;
+        double limit = 0.0;
+        for (const auto& centroid : sorted) {
+            if (!merged.empty() && cumulative + merged.back().weight + centroid.weight <= limit) {
+                Centroid& last = merged.back();
+                last.mean += (centroid.mean - last.mean) * centroid.weight / (last.weight + centroid.weight);
+                last.weight += centroid.weight;
+                continue;
+            }
+            if (!merged.empty()) {
+                cumulative += merged.back().weight;
+            }
+            merged.push_back(centroid);
+            limit = count * getQuantileOfScale(getScale(cumulative / count) + 1);
+        }
+        return merged;
+    }
+
+    void compress() {
+        centroids = getMerged();
+        buffer.clear();
+    }
+};
+
+// HDR histogram over a bounded range [0, maxValue] at a fixed resolution: values are counted in
+// log-linear buckets, exact below 2^subBucketBits units and with a relative error of at most
+// 10^-significantDigits above. Memory depends only on the range and precision, and histograms
+// with the same configuration merge by adding counts. Values above maxValue are clamped and
+// counted as overflows.
+class HdrHistogram {
+public:
+    HdrHistogram(double resolution, double maxValue, int significantDigits)
+        : resolution(resolution), maxUnits(uint64_t(std::ceil(maxValue / resolution))), overflows(0), count(0) {
+        subBucketBits = int(std::ceil(std::log2(2 * std::pow(10.0, significantDigits))));
+        subBucketCount = uint64_t(1) << subBucketBits;
+        halfCount = subBucketCount / 2;
+        counts.assign(getIndex(maxUnits) + 1, 0);
+    }
+
+    void add(double value) {
+        uint64_t units = value <= 0 ? 0 : uint64_t(std::llround(value / resolution));
+        if (units > maxUnits) {
+            units = maxUnits;
+            ++overflows;
+        }
+        ++counts[getIndex(units)];
+        ++count;
+    }
+
+    void merge(const HdrHistogram& other) {
+        if (other.resolution != resolution || other.maxUnits != maxUnits || other.subBucketBits != subBucketBits) {
+            throw std::invalid_argument("cannot merge HDR histograms with different configurations");
+        }
+        for (size_t i = 0; i < counts.size(); ++i) {
+            counts[i] += other.counts[i];
+        }
+        overflows += other.overflows;
+        count += other.count;
+    }
+
+    // Midpoint of the bucket holding the value of rank q * count
+    double getQuantile(double q) const {
+        if (count == 0) return NAN;
+        double target = std::max(1.0, std::ceil(q * count));
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            cumulative += counts[i];
+            if (cumulative >= target) {
+                uint64_t low, high;
+                getBucketRange(i, low, high);
+                return (low + high) / 2.0 * resolution;
+            }
+        }
+        return maxUnits * resolution;
+    }
+
+    // Bound on the relative error of a reported value above the linear range
+    double getRelativeError() const {
+        return 1.0 / halfCount;
+    }
+
+    uint64_t getCount() const {
+        return count;
+    }
+
+    uint64_t getOverflows() const {
+        return overflows;
+    }
+
+    size_t getBuckets() const {
+        return counts.size();
+    }
+
+private:
+    double resolution;
+    uint64_t maxUnits;
+    int subBucketBits;
+    uint64_t subBucketCount;
+    uint64_t halfCount;
+    std::vector<uint64_t> counts;
+    uint64_t overflows;
+    uint64_t count;
+
+    size_t getIndex(uint64_t units) const {
+        if (units < subBucketCount) {
+            return units;
+        }
+        int shift = std::bit_width(units) - subBucketBits;
+        uint64_t subBucket = units >> shift;
+        return subBucketCount + (shift - 1) * halfCount + (subBucket - halfCount);
+    }
+
+    void getBucketRange(size_t index, uint64_t& low, uint64_t& high) const {
+        if (index < subBucketCount) {
+            low = index;
+            high = index + 1;
+            return;
+        }
+        size_t offset = index - subBucketCount;
+        int shift = offset / halfCount + 1;
+        uint64_t subBucket = offset % halfCount + halfCount;
+        low = subBucket << shift;
+        high = (subBucket + 1) << shift;
+    }
+};
+
+// Response-time sketches keyed by (algorithm, server, time window). Server -1 aggregates every
+// server of the algorithm, and window -1 the whole run. Recorders from different threads or
+// replications merge key by key; each recorder gets its own seed so that the same key in two
+// replications does not flip the same compaction coins.
+class LatencyRecorder {
+public:
+    // Which sketch a reported quantile comes from
+    enum class Source { Kll, Hdr, TDigest };
+
+    struct Sketches {
+        KllSketch kll;
+        HdrHistogram hdr;
+        TDigest tdigest;
+
+        // Body quantiles come from KLL, whose rank error is uniform over q. At and above
+        // TAIL_QUANTILE that error is a large fraction of the tail, so the tail comes from HDR, whose
+        // error is relative to the value, or from the t-digest once the tail runs past the HDR range.
+        Source getSource(double q) const {
+            if (q < TAIL_QUANTILE) {
+                return Source::Kll;
+            }
+            if (std::ceil(q * hdr.getCount()) <= hdr.getCount() - hdr.getOverflows()) {
+                return Source::Hdr;
+            }
+            return Source::TDigest;
+        }
+
+        double getQuantile(double q) const {
+            switch (getSource(q)) {
+            case Source::Kll:
+                return kll.getQuantile(q);
+            case Source::Hdr:
+                return hdr.getQuantile(q);
+            default:
+                return tdigest.getQuantile(q);
+            }
+        }
+    };
+
+    static constexpr double TAIL_QUANTILE = 0.99;
+    static constexpr double HDR_RESOLUTION = 0.001;
+    static constexpr double HDR_MAX_VALUE = 10000.0;
+    static constexpr int HDR_SIGNIFICANT_DIGITS = 2;
+    static constexpr double TDIGEST_COMPRESSION = 200;
+
+    LatencyRecorder(double windowLength, uint64_t seed = 0, int kllK = 200)
+        : windowLength(windowLength), seed(seed), kllK(kllK) {}
+
+    void record(const std::string& algorithm, int serverId, double time, double responseTime) {
+        int window = int(time / windowLength);
+        for (const auto& key : {Key{algorithm, serverId, window}, Key{algorithm, serverId, -1},
+                                Key{algorithm, -1, window}, Key{algorithm, -1, -1}}) {
+            Sketches& keySketches = getSketches(key);
+            keySketches.kll.add(responseTime);
+            keySketches.hdr.add(responseTime);
+            keySketches.tdigest.add(responseTime);
+        }
+    }
+
+    void merge(const LatencyRecorder& other) {
+        for (const auto& [key, sketches] : other.sketches) {
+            Sketches& keySketches = getSketches(key);
+            keySketches.kll.merge(sketches.kll);
+            keySketches.hdr.merge(sketches.hdr);
+            keySketches.tdigest.merge(sketches.tdigest);
+        }
+    }
+
+    const Sketches* find(const std::string& algorithm, int serverId, int window) const {
+        auto it = sketches.find(Key{algorithm, serverId, window});
+        return it == sketches.end() ? nullptr : &it->second;
+    }
+
+    size_t getNumSketches() const {
+        return sketches.size();
+    }
+
+    static const char* getSourceName(Source source) {
+        switch (source) {
+        case Source::Kll:
+            return "KLL";
+        case Source::Hdr:
+            return "HDR";
+        default:
+            return "t-digest";
+        }
+    }
+
+private:
+    typedef std::tuple<std::string, int, int> Key;
+
+    double windowLength;
+    uint64_t seed;
+    int kllK;
+    std::map<Key, Sketches> sketches;
+
+    // SplitMix64 finalizer, so that nearby keys and recorder seeds give unrelated generator seeds
+    static uint64_t mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    Sketches& getSketches(const Key& key) {
+        auto it = sketches.find(key);
+        if (it == sketches.end()) {
+            // Seeds differ per key and per recorder so compaction coins are independent across sketches
+            uint64_t keySeed = std::hash<std::string>()(std::get<0>(key)) ^ (uint64_t(std::get<1>(key) + 1) << 20) ^
+                               (uint64_t(std::get<2>(key) + 1) << 40);
+            it = sketches
+                     .emplace(key, Sketches{KllSketch(kllK, mix(keySeed ^ mix(seed))),
+                                            HdrHistogram(HDR_RESOLUTION, HDR_MAX_VALUE, HDR_SIGNIFICANT_DIGITS),
+                                            TDigest(TDIGEST_COMPRESSION)})
+                     .first;
+        }
+        return it->second;
+    }
+};
+
+// Dispatching policies, selecting a server from the times at which each server becomes free
+int selectRandom(const std::vector<double>& freeTimes, std::mt19937_64& gen, int&) {
+    return std::uniform_int_distribution<>(0, freeTimes.size() - 1)(gen);
+}
+
+int selectRoundRobin(const std::vector<double>& freeTimes, std::mt19937_64&, int& currentServer) {
+    int selected = currentServer;
+    currentServer = (currentServer + 1) % freeTimes.size();
+    return selected;
+}
+
+int selectPowerOfTwoChoices(const std::vector<double>& freeTimes, std::mt19937_64& gen, int&) {
+    std::uniform_int_distribution<> dis(0, freeTimes.size() - 1);
+    int first = dis(gen);
+    int second = dis(gen);
+    return freeTimes[second] < freeTimes[first] ? second : first;
+}
+
+// Helper function to run one replication: Poisson arrivals dispatched to single-slot FIFO servers
+// with exponential service, where the response time of a request follows from the server's free
+// time (Lindley recursion). Exact response times are optionally kept for validation.
+void runReplication(const std::string& algorithm, int (*select)(const std::vector<double>&, std::mt19937_64&, int&),
+                    int numServers, long long numRequests, double utilization, uint64_t seed, LatencyRecorder& recorder,
+                    std::vector<double>* exact) {
+    std::mt19937_64 gen(seed);
+    std::exponential_distribution<> interArrivalDis(utilization * numServers);
+    std::exponential_distribution<> serviceDis(1.0);
+    std::vector<double> freeTimes(numServers, 0.0);
+    int currentServer = 0;
+    double time = 0.0;
+    for (long long i = 0; i < numRequests; ++i) {
+        time += interArrivalDis(gen);
+        int serverId = select(freeTimes, gen, currentServer);
+        double startTime = std::max(time, freeTimes[serverId]);
+        freeTimes[serverId] = startTime + serviceDis(gen);
+        double responseTime = freeTimes[serverId] - time;
+        recorder.record(algorithm, serverId, time, responseTime);
+        if (exact) {
+            exact->push_back(responseTime);
+        }
+    }
+}
+
+int main() {
+    const int NUM_SERVERS = 16;
+    const long long REQUESTS_PER_REPLICATION = 125000;
+    const int NUM_REPLICATIONS = 8;
+    const double UTILIZATION = 0.9;
+    const double WINDOW_LENGTH = 2000.0;
+    const std::vector<double> QUANTILES = {0.5, 0.9, 0.99, 0.999};
+    const std::vector<std::pair<std::string, int (*)(const std::vector<double>&, std::mt19937_64&, int&)>> ALGORITHMS =
+        {{"Random", selectRandom}, {"Round-Robin", selectRoundRobin}, {"Power of Two", selectPowerOfTwoChoices}};
+
+    // Every (algorithm, replication) pair records into its own recorder on a pool worker; the
+    // recorders are merged afterwards, as they would be across hosts
+    int numJobs = ALGORITHMS.size() * NUM_REPLICATIONS;
+    std::vector<LatencyRecorder> recorders;
+    for (int job = 0; job < numJobs; ++job) {
+        recorders.push_back(LatencyRecorder(WINDOW_LENGTH, job + 1));
+    }
+    std::vector<std::vector<double>> exact(numJobs);
+    WorkStealingPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    {
+        WorkStealingPool::TaskGroup group(pool);
+        for (int job = 0; job < numJobs; ++job) {
+            group.run([&, job] {
+                const auto& [name, select] = ALGORITHMS[job / NUM_REPLICATIONS];
+                runReplication(name, select, NUM_SERVERS, REQUESTS_PER_REPLICATION, UTILIZATION, job + 1,
+                               recorders[job], &exact[job]);
+            });
+        }
+        group.wait();
+    }
+
+    LatencyRecorder merged(WINDOW_LENGTH);
+    for (const auto& recorder : recorders) {
+        merged.merge(recorder);
+    }
+
+    std::cout << std::setw(16) << "Algorithm" << std::setw(10) << "Quantile" << std::setw(12) << "Exact"
+              << std::setw(12) << "KLL" << std::setw(16) << "KLL Rank Err" << std::setw(12) << "HDR"
+              << std::setw(16) << "HDR Rel Err" << std::setw(12) << "t-digest" << std::setw(16) << "TD Rel Err"
+              << std::setw(12) << "Reported" << std::setw(12) << "Source" << std::endl;
+    std::cout << std::fixed;
+    double maxRankError = 0.0;
+    double maxRelativeError = 0.0;
+    double maxTailError = 0.0;
+    const LatencyRecorder::Sketches* anySketches = nullptr;
+    for (int algorithm = 0; algorithm < int(ALGORITHMS.size()); ++algorithm) {
+        std::vector<double> values;
+        for (int replication = 0; replication < NUM_REPLICATIONS; ++replication) {
+            const auto& replicationValues = exact[algorithm * NUM_REPLICATIONS + replication];
+            values.insert(values.end(), replicationValues.begin(), replicationValues.end());
+        }
+        std::sort(values.begin(), values.end());
+
+        const LatencyRecorder::Sketches* sketches = merged.find(ALGORITHMS[algorithm].first, -1, -1);
+        anySketches = sketches;
+        for (double q : QUANTILES) {
+            double exactValue = values[std::min(values.size() - 1, size_t(std::ceil(q * values.size())) - 1)];
+            double kllValue = sketches->kll.getQuantile(q);
+            double hdrValue = sketches->hdr.getQuantile(q);
+            double tdigestValue = sketches->tdigest.getQuantile(q);
+            double reportedValue = sketches->getQuantile(q);
+            double kllRank = double(std::upper_bound(values.begin(), values.end(), kllValue) - values.begin()) /
+                             values.size();
+            double rankError = std::abs(kllRank - q);
+            double relativeError = std::abs(hdrValue - exactValue) / exactValue;
+            double tdigestError = std::abs(tdigestValue - exactValue) / exactValue;
+            maxRankError = std::max(maxRankError, rankError);
+            maxRelativeError = std::max(maxRelativeError, relativeError);
+            if (q >= LatencyRecorder::TAIL_QUANTILE) {
+                maxTailError = std::max(maxTailError, std::abs(reportedValue - exactValue) / exactValue);
+            }
+            std::cout << std::setw(16) << ALGORITHMS[algorithm].first << std::setw(10) << std::setprecision(3) << q
+                      << std::setw(12) << exactValue << std::setw(12) << kllValue << std::setw(16)
+                      << std::setprecision(5) << rankError << std::setw(12) << std::setprecision(3) << hdrValue
+                      << std::setw(16) << std::setprecision(5) << relativeError << std::setw(12)
+                      << std::setprecision(3) << tdigestValue << std::setw(16) << std::setprecision(5) << tdigestError
+                      << std::setw(12) << std::setprecision(3) << reportedValue << std::setw(12)
+                      << LatencyRecorder::getSourceName(sketches->getSource(q)) << std::endl;
+        }
+    }
+
+    std::cout << std::endl;
+    std::cout << std::setw(36) << "Requests per Algorithm" << std::setw(16) << anySketches->kll.getCount()
+              << std::endl;
+    std::cout << std::setw(36) << "Sketches (alg x server x window)" << std::setw(16) << merged.getNumSketches()
+              << std::endl;
+    std::cout << std::setw(36) << "KLL Retained Items" << std::setw(16) << anySketches->kll.getRetained()
+              << std::endl;
+    std::cout << std::setw(36) << "KLL Max Rank Error / Bound" << std::setw(16) << std::setprecision(5)
+              << maxRankError << " / " << anySketches->kll.getRankError() << std::endl;
+    std::cout << std::setw(36) << "HDR Buckets" << std::setw(16) << anySketches->hdr.getBuckets() << std::endl;
+    std::cout << std::setw(36) << "HDR Max Relative Error / Bound" << std::setw(16) << maxRelativeError << " / "
+              << anySketches->hdr.getRelativeError() << std::endl;
+    std::cout << std::setw(36) << "t-digest Centroids" << std::setw(16) << anySketches->tdigest.getCentroids()
+              << std::endl;
+    std::cout << std::setw(36) << "Reported Max Tail Relative Error" << std::setw(16) << maxTailError << std::endl;
+
+    // Per-server and per-window views come from the same merged recorder
+    const LatencyRecorder::Sketches* server = merged.find("Power of Two", 0, -1);
+    const LatencyRecorder::Sketches* window = merged.find("Random", -1, 0);
+    if (server) {
+        std::cout << std::setw(36) << "Power of Two, server 0, p99" << std::setw(16) << std::setprecision(3)
+                  << server->getQuantile(0.99) << std::endl;
+    }
+    if (window) {
+        std::cout << std::setw(36) << "Random, window 0, p99" << std::setw(16) << std::setprecision(3)
+                  << window->getQuantile(0.99) << std::endl;
+    }
+
+    return 0;
+}
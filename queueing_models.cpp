@@ -0,0 +1,268 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <fmt/format.h>
+
+// Dispatching policies covered by the sweep
+enum class Policy {
+    Random,
+    RoundRobin,
+    PowerOfD,
+    JoinShortestQueue
+};
+
+std::string getPolicyName(Policy policy, int d) {
+    switch (policy) {
+    case Policy::Random:
+        return "Random";
+    case Policy::RoundRobin:
+        return "Round-Robin";
+    case Policy::PowerOfD:
+        return "JSQ(" + std::to_string(d) + ")";
+    case Policy::JoinShortestQueue:
+        return "JSQ";
+    }
+    return "";
+}
+
+// One sweep cell: numServers identical single-slot FIFO servers of rate serviceRate, fed by a
+// Poisson stream of numServers * utilization * serviceRate requests per unit of time
+struct SweepCell {
+    Policy policy;
+    int numServers;
+    double utilization;
+    double serviceRate = 1.0;
+    int d = 2;                       // Choices for Policy::PowerOfD
+    bool exponentialService = true;
+};
+
+// Closed-form or fixed-point answer for a sweep cell
+struct AnalyticResult {
+    double meanResponseTime;
+    std::string model;
+    bool isLowerBound; // The model bounds the cell from below instead of predicting it
+};
+
+// M/M/1 mean response time
+double mm1ResponseTime(double arrivalRate, double serviceRate) {
+    return 1.0 / (serviceRate - arrivalRate);
+}
+
+// Erlang-C: probability that an arrival waits in an M/M/c queue with offered load a = lambda / mu
+double erlangC(int c, double offeredLoad) {
+    // Erlang-B by the stable recursion, then converted to Erlang-C
+    double erlangB = 1.0;
+    for (int k = 1; k <= c; ++k) {
+        erlangB = offeredLoad * erlangB / (k + offeredLoad * erlangB);
+    }
+    double rho = offeredLoad / c;
+    return erlangB / (1.0 - rho + rho * erlangB);
+}
+
+// M/M/c mean response time: one central queue in front of c servers
+double mmcResponseTime(int c, double arrivalRate, double serviceRate) {
+    double waitProbability = erlangC(c, arrivalRate / serviceRate);
+    return waitProbability / (c * serviceRate - arrivalRate) + 1.0 / serviceRate;
+}
+
+// Round-robin turns a Poisson stream into Erlang-n arrivals at each server (E_n/M/1). The G/M/1
+// result gives E[T] = 1 / (mu (1 - sigma)), with sigma the root in (0, 1) of
+// sigma = A*(mu (1 - sigma)) and A*(s) = (lambda / (lambda + s))^n the interarrival transform.
+double roundRobinResponseTime(int numServers, double arrivalRate, double serviceRate) {
+    double sigma = arrivalRate / (numServers * serviceRate);
+    for (int iteration = 0; iteration < 1000; ++iteration) {
+        double next = std::pow(arrivalRate / (arrivalRate + serviceRate * (1.0 - sigma)), numServers);
+        if (std::abs(next - sigma) < 1e-13) {
+            sigma = next;
+            break;
+        }
+        sigma = next;
+    }
+    return 1.0 / (serviceRate * (1.0 - sigma));
+}
+
+// Mean-field limit of JSQ(d) (Mitzenmacher; Vvedenskaya et al.): the fraction of servers with at
+// least k requests is s_k = rho^((d^k - 1) / (d - 1)), and Little's law on the mean queue length
+// sum_k s_k gives the response time. Exact as the number of servers grows.
+double powerOfDResponseTime(int d, double utilization, double serviceRate) {
+    double meanQueueLength = 0.0;
+    for (int k = 1; k < 1000; ++k) {
+        double exponent = d == 1 ? k : (std::pow(double(d), k) - 1.0) / (d - 1);
+        double fraction = std::pow(utilization, exponent);
+        meanQueueLength += fraction;
+        if (fraction < 1e-15) break;
+    }
+    return meanQueueLength / (utilization * serviceRate);
+}
+
+// Answers a sweep cell analytically when a model applies: Poisson arrivals and exponential
+// service, identical servers, and a policy with a known result. Random splitting is exactly
+// n independent M/M/1 queues, round-robin is exactly E_n/M/1, JSQ(d) uses the mean-field fixed
+// point, and full JSQ is bounded below by the M/M/n central queue.
+std::optional<AnalyticResult> solveAnalytic(const SweepCell& cell) {
+    if (!cell.exponentialService || cell.utilization <= 0 || cell.utilization >= 1) {
+        return std::nullopt;
+    }
+    double arrivalRate = cell.numServers * cell.utilization * cell.serviceRate;
+    switch (cell.policy) {
+    case Policy::Random:
+        return AnalyticResult{mm1ResponseTime(arrivalRate / cell.numServers, cell.serviceRate), "M/M/1 split", false};
+    case Policy::RoundRobin:
+        return AnalyticResult{roundRobinResponseTime(cell.numServers, arrivalRate, cell.serviceRate), "E_n/M/1",
+                              false};
+    case Policy::PowerOfD:
+        return AnalyticResult{powerOfDResponseTime(cell.d, cell.utilization, cell.serviceRate), "Mean-field", false};
+    case Policy::JoinShortestQueue:
+        return AnalyticResult{mmcResponseTime(cell.numServers, arrivalRate, cell.serviceRate), "M/M/n bound", true};
+    }
+    return std::nullopt;
+}
+
+// Discrete-event simulation of a sweep cell, with exponential or deterministic service: each
+// server keeps the departure times of the requests in it, so its queue length at an arrival is
+// exact, and FIFO service makes a request's departure the later of its arrival and the previous
+// departure, plus its service time
+struct SimulationResult {
+    double meanResponseTime;
+    double duration; // Microseconds
+};
+
+SimulationResult simulateCell(const SweepCell& cell, long long numRequests, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    double arrivalRate = cell.numServers * cell.utilization * cell.serviceRate;
+    std::exponential_distribution<> interArrivalDis(arrivalRate);
+    std::exponential_distribution<> serviceDis(cell.serviceRate);
+    std::uniform_int_distribution<> serverDis(0, cell.numServers - 1);
+    std::vector<std::deque<double>> departures(cell.numServers);
+    int currentServer = 0;
+
+    auto getQueueLength = [&](int serverId, double time) {
+        std::deque<double>& server = departures[serverId];
+        while (!server.empty() && server.front() <= time) {
+            server.pop_front();
+        }
+        return int(server.size());
+    };
+
+    auto startTime = std::chrono::steady_clock::now();
+    double time = 0.0;
+    double totalResponseTime = 0.0;
+    long long warmUp = numRequests / 10;
+    for (long long i = 0; i < numRequests + warmUp; ++i) {
+        time += interArrivalDis(gen);
+        int serverId = 0;
+        switch (cell.policy) {
+        case Policy::Random:
+            serverId = serverDis(gen);
+            break;
+        case Policy::RoundRobin:
+            serverId = currentServer;
+            currentServer = (currentServer + 1) % cell.numServers;
+            break;
+        case Policy::PowerOfD: {
+            serverId = serverDis(gen);
+            int minLength = getQueueLength(serverId, time);
+            for (int choice = 1; choice < cell.d; ++choice) {
+                int candidate = serverDis(gen);
+                int length = getQueueLength(candidate, time);
+                if (length < minLength) {
+                    minLength = length;
+                    serverId = candidate;
+                }
+            }
+            break;
+        }
+        case Policy::JoinShortestQueue: {
+            int minLength = getQueueLength(0, time);
+            for (int candidate = 1; candidate < cell.numServers && minLength > 0; ++candidate) {
+                int length = getQueueLength(candidate, time);
+                if (length < minLength) {
+                    minLength = length;
+                    serverId = candidate;
+                }
+            }
+            break;
+        }
+        }
+
+        std::deque<double>& server = departures[serverId];
+        double serviceTime = cell.exponentialService ? serviceDis(gen) : 1.0 / cell.serviceRate;
+        double departure = std::max(time, server.empty() ? 0.0 : server.back()) + serviceTime;
+        server.push_back(departure);
+        if (i >= warmUp) {
+            totalResponseTime += departure - time;
+        }
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    return {totalResponseTime / numRequests,
+            double(std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count())};
+}
+
+int main() {
+    const int NUM_SERVERS = 100;
+    const long long NUM_REQUESTS = 1000000;
+    const double TOLERANCE = 0.05;
+    const std::vector<double> UTILIZATIONS = {0.5, 0.8, 0.9};
+
+    std::vector<SweepCell> cells;
+    for (double utilization : UTILIZATIONS) {
+        cells.push_back({Policy::Random, NUM_SERVERS, utilization});
+        cells.push_back({Policy::RoundRobin, NUM_SERVERS, utilization});
+        cells.push_back({Policy::PowerOfD, NUM_SERVERS, utilization, 1.0, 2});
+        cells.push_back({Policy::PowerOfD, NUM_SERVERS, utilization, 1.0, 3});
+        cells.push_back({Policy::JoinShortestQueue, NUM_SERVERS, utilization});
+        // Deterministic service has no model here and falls back to simulation
+        cells.push_back({Policy::PowerOfD, NUM_SERVERS, utilization, 1.0, 2, false});
+    }
+
+    std::cout << std::setw(14) << "Policy" << std::setw(8) << "rho" << std::setw(14) << "Model" << std::setw(12)
+              << "Analytic" << std::setw(14) << "Solve (μs)" << std::setw(12) << "Simulated" << std::setw(12)
+              << "Sim (ms)" << std::setw(12) << "Error" << std::setw(10) << "Check" << std::endl;
+    std::cout << std::fixed;
+
+    int numChecked = 0;
+    int numPassed = 0;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        const SweepCell& cell = cells[i];
+        auto startTime = std::chrono::steady_clock::now();
+        std::optional<AnalyticResult> analytic = solveAnalytic(cell);
+        auto endTime = std::chrono::steady_clock::now();
+        double solveTime = std::chrono::duration<double, std::micro>(endTime - startTime).count();
+
+        SimulationResult simulated = simulateCell(cell, NUM_REQUESTS, i + 1);
+
+        std::cout << std::setw(14) << getPolicyName(cell.policy, cell.d) + (cell.exponentialService ? "" : " M/D")
+                  << std::setw(8) << std::setprecision(2)
+                  << cell.utilization;
+        if (!analytic) {
+            std::cout << std::setw(14) << "-" << std::setw(12) << "-" << std::setw(14) << "-" << std::setw(12)
+                      << std::setprecision(3) << simulated.meanResponseTime << std::setw(12) << std::setprecision(1)
+                      << simulated.duration / 1000 << std::setw(12) << "-" << std::setw(10) << "simulate" << std::endl;
+            continue;
+        }
+
+        // Predictions must match within the tolerance; bounds must not be beaten by more than it
+        double error = (simulated.meanResponseTime - analytic->meanResponseTime) / analytic->meanResponseTime;
+        bool passed = analytic->isLowerBound ? error > -TOLERANCE : std::abs(error) <= TOLERANCE;
+        ++numChecked;
+        numPassed += passed;
+        std::cout << std::setw(14) << analytic->model << std::setw(12) << std::setprecision(3)
+                  << analytic->meanResponseTime << std::setw(14) << std::setprecision(2) << solveTime << std::setw(12)
+                  << std::setprecision(3) << simulated.meanResponseTime << std::setw(12) << std::setprecision(1)
+                  << simulated.duration / 1000 << std::setw(11) << std::setprecision(2) << 100 * error << '%'
+                  << std::setw(10) << (passed ? "pass" : "FAIL") << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << "Validated " << numPassed << " of " << numChecked << " analytic cells within "
+              << std::setprecision(0) << 100 * TOLERANCE << "%" << std::endl;
+
+    return numPassed == numChecked ? 0 : 1;
+}
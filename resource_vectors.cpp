@@ -0,0 +1,473 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <queue>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <fmt/format.h>
+
+// Resources every server offers and every task consumes
+constexpr int NUM_RESOURCES = 3;
+const std::array<std::string, NUM_RESOURCES> RESOURCE_NAMES = {"CPU", "Memory", "Network"};
+
+typedef std::array<double, NUM_RESOURCES> ResourceVector;
+
+// SIMD vector types holding one value per server, as wide as the target's vector registers: GCC
+// lowers compares on wider vectors to scalar code. Vectors are passed by reference only, so the
+// kernels do not depend on the vector calling convention of the target.
+#if defined(__AVX512F__)
+constexpr int LANES = 8;
+#elif defined(__AVX__)
+constexpr int LANES = 4;
+#else
+constexpr int LANES = 2;
+#endif
+typedef double Lane __attribute__((vector_size(LANES * sizeof(double))));
+typedef long long LaneMask __attribute__((vector_size(LANES * sizeof(long long))));
+
+// Capacities and usage of a set of servers, stored per resource (structure of arrays) in lanes of
+// LANES servers so that the scoring kernels load one resource of a lane of servers at a time. The
+// arrays are padded to whole lanes with servers of no free capacity, which no task fits.
+class ServerResources {
+public:
+    ServerResources(const std::vector<ResourceVector>& capacities)
+        : numServers(capacities.size()), numLanes((capacities.size() + LANES - 1) / LANES), capacities(capacities) {
+        for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+            free[resource].assign(numLanes, Lane{} - 1.0);
+            inverseCapacities[resource].assign(numLanes, Lane{});
+            for (int serverId = 0; serverId < numServers; ++serverId) {
+                if (capacities[serverId][resource] <= 0) {
+                    throw std::invalid_argument("Server capacities must be positive");
+                }
+                free[resource][serverId / LANES][serverId % LANES] = capacities[serverId][resource];
+                inverseCapacities[resource][serverId / LANES][serverId % LANES] = 1.0 / capacities[serverId][resource];
+            }
+        }
+    }
+
+    int getNumServers() const {
+        return numServers;
+    }
+
+    int getNumLanes() const {
+        return numLanes;
+    }
+
+    double getFree(int serverId, int resource) const {
+        return free[resource][serverId / LANES][serverId % LANES];
+    }
+
+    double getInverseCapacity(int serverId, int resource) const {
+        return inverseCapacities[resource][serverId / LANES][serverId % LANES];
+    }
+
+    const Lane& getFreeLane(int lane, int resource) const {
+        return free[resource][lane];
+    }
+
+    const Lane& getInverseCapacityLane(int lane, int resource) const {
+        return inverseCapacities[resource][lane];
+    }
+
+    const ResourceVector& getCapacity(int serverId) const {
+        return capacities[serverId];
+    }
+
+    void allocate(int serverId, const ResourceVector& demand) {
+        for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+            free[resource][serverId / LANES][serverId % LANES] -= demand[resource];
+        }
+    }
+
+    void release(int serverId, const ResourceVector& demand) {
+        for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+            free[resource][serverId / LANES][serverId % LANES] += demand[resource];
+        }
+    }
+
+private:
+    int numServers;
+    int numLanes;
+    std::vector<ResourceVector> capacities;
+    std::array<std::vector<Lane>, NUM_RESOURCES> free;
+    std::array<std::vector<Lane>, NUM_RESOURCES> inverseCapacities;
+};
+
+// Placement policies. Each scores a server from the task's demand and the server's free capacity,
+// both normalized by the server's capacity; the feasible server with the lowest score wins. The
+// scores are templates over the value type, so the scalar reference and the SIMD kernel share
+// one formula and pick identical servers.
+
+// Least-loaded on CPU alone, the single-resource balancers' view of a server
+struct LeastLoadedPolicy {
+    static constexpr const char* NAME = "Least-Loaded (CPU)";
+
+    template <typename T>
+    static void score(const std::array<T, NUM_RESOURCES>& demand, const std::array<T, NUM_RESOURCES>& free, T& score) {
+        score = demand[0] - free[0];
+    }
+};
+
+// Tetris-style alignment: prefer the server whose free capacity points the same way as the demand
+struct DotProductPolicy {
+    static constexpr const char* NAME = "Dot Product";
+
+    template <typename T>
+    static void score(const std::array<T, NUM_RESOURCES>& demand, const std::array<T, NUM_RESOURCES>& free, T& score) {
+        T alignment = demand[0] * free[0];
+        for (int resource = 1; resource < NUM_RESOURCES; ++resource) {
+            alignment += demand[resource] * free[resource];
+        }
+        score = -alignment;
+    }
+};
+
+// Best fit: prefer the server left with the least free capacity, summed over the resources
+struct BestFitPolicy {
+    static constexpr const char* NAME = "Best Fit";
+
+    template <typename T>
+    static void score(const std::array<T, NUM_RESOURCES>& demand, const std::array<T, NUM_RESOURCES>& free, T& score) {
+        T remaining = free[0] - demand[0];
+        for (int resource = 1; resource < NUM_RESOURCES; ++resource) {
+            remaining += free[resource] - demand[resource];
+        }
+        score = remaining;
+    }
+};
+
+// Dominant Resource Fairness across servers: prefer the server whose dominant share (its most
+// used resource) is lowest after the placement
+struct DominantResourcePolicy {
+    static constexpr const char* NAME = "Dominant Resource";
+
+    template <typename T>
+    static void score(const std::array<T, NUM_RESOURCES>& demand, const std::array<T, NUM_RESOURCES>& free, T& score) {
+        T dominantShare = demand[0] - free[0];
+        for (int resource = 1; resource < NUM_RESOURCES; ++resource) {
+            T share = demand[resource] - free[resource];
+            dominantShare = share > dominantShare ? share : dominantShare;
+        }
+        score = dominantShare;
+    }
+};
+
+// Helper function to select a server one server at a time; returns -1 when the task fits nowhere
+template <typename Policy>
+int selectServerScalar(const ServerResources& servers, const ResourceVector& demand) {
+    double bestScore = INFINITY;
+    int bestServer = -1;
+    for (int serverId = 0; serverId < servers.getNumServers(); ++serverId) {
+        std::array<double, NUM_RESOURCES> normalizedDemand, normalizedFree;
+        bool fits = true;
+        for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+            double free = servers.getFree(serverId, resource);
+            fits = fits && demand[resource] <= free;
+            normalizedDemand[resource] = demand[resource] * servers.getInverseCapacity(serverId, resource);
+            normalizedFree[resource] = free * servers.getInverseCapacity(serverId, resource);
+        }
+        double score;
+        Policy::score(normalizedDemand, normalizedFree, score);
+        if (fits && score < bestScore) {
+            bestScore = score;
+            bestServer = serverId;
+        }
+    }
+    return bestServer;
+}
+
+// Helper function to select a server with the SIMD kernel: every lane scores its own column of
+// servers and keeps its best feasible one, and the lanes are reduced at the end.
+// Lanes visit their servers in increasing order and the reduction breaks ties by id, so the choice
+// is the one selectServerScalar makes.
+template <typename Policy>
+int selectServer(const ServerResources& servers, const ResourceVector& demand) {
+    const Lane none = Lane{} + INFINITY;
+    Lane laneIds;
+    for (int lane = 0; lane < LANES; ++lane) {
+        laneIds[lane] = lane;
+    }
+    Lane bestScores = none;
+    Lane bestServers = Lane{} - 1.0;
+    std::array<Lane, NUM_RESOURCES> demands;
+    for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+        demands[resource] = Lane{} + demand[resource];
+    }
+
+    for (int lane = 0; lane < servers.getNumLanes(); ++lane) {
+        std::array<Lane, NUM_RESOURCES> normalizedDemand, normalizedFree;
+        LaneMask fits = LaneMask{} - 1;
+        for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+            const Lane& free = servers.getFreeLane(lane, resource);
+            const Lane& inverseCapacity = servers.getInverseCapacityLane(lane, resource);
+            fits &= demands[resource] <= free;
+            normalizedDemand[resource] = demands[resource] * inverseCapacity;
+            normalizedFree[resource] = free * inverseCapacity;
+        }
+        Lane score;
+        Policy::score(normalizedDemand, normalizedFree, score);
+        LaneMask better = fits & (score < bestScores);
+        bestScores = (Lane)(((LaneMask)score & better) | ((LaneMask)bestScores & ~better));
+        Lane serverIds = laneIds + double(lane * LANES);
+        bestServers = (Lane)(((LaneMask)serverIds & better) | ((LaneMask)bestServers & ~better));
+    }
+
+    double bestScore = bestScores[0];
+    double bestServer = bestServers[0];
+    for (int lane = 1; lane < LANES; ++lane) {
+        bool better = bestScores[lane] < bestScore || (bestScores[lane] == bestScore && bestServers[lane] < bestServer);
+        if (better) {
+            bestScore = bestScores[lane];
+            bestServer = bestServers[lane];
+        }
+    }
+    return bestServer >= 0 ? int(bestServer) : -1;
+}
+
+// Task classes of the workload: each class leans on one resource
+struct TaskClass {
+    ResourceVector meanDemand;
+    double weight;
+};
+
+// Helper function to generate heterogeneous server capacities (cores, GiB, Gbit/s)
+std::vector<ResourceVector> generateCapacities(int numServers, std::mt19937& gen) {
+    std::vector<ResourceVector> capacities(numServers);
+    std::uniform_int_distribution<> shapeDis(0, 2);
+    for (auto& capacity : capacities) {
+        switch (shapeDis(gen)) {
+        case 0:
+            capacity = {64, 128, 25}; // Compute-optimized
+            break;
+        case 1:
+            capacity = {16, 256, 10}; // Memory-optimized
+            break;
+        default:
+            capacity = {32, 64, 100}; // Network-optimized
+            break;
+        }
+    }
+    return capacities;
+}
+
+// Helper function to draw a task's demand: its class's mean, scaled per resource by up to +-50%
+ResourceVector generateDemand(const std::vector<TaskClass>& classes, std::discrete_distribution<>& classDis,
+                              std::mt19937& gen) {
+    std::uniform_real_distribution<> scaleDis(0.5, 1.5);
+    const TaskClass& taskClass = classes[classDis(gen)];
+    ResourceVector demand;
+    for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+        demand[resource] = taskClass.meanDemand[resource] * scaleDis(gen);
+    }
+    return demand;
+}
+
+// Outcome of an online placement run
+struct PlacementResult {
+    double acceptedFraction;
+    ResourceVector utilization; // Time-averaged share of each resource in use
+};
+
+// Helper function to run an online placement: one task arrives per time unit and holds its
+// resources for an exponential lifetime, and a task that fits nowhere is rejected
+template <typename Policy>
+PlacementResult simulatePlacement(const std::vector<ResourceVector>& capacities, const std::vector<TaskClass>& classes,
+                                  int numTasks, double meanLifetime, uint64_t seed) {
+    ServerResources servers(capacities);
+    std::mt19937 gen(seed);
+    std::vector<double> weights;
+    for (const auto& taskClass : classes) {
+        weights.push_back(taskClass.weight);
+    }
+    std::discrete_distribution<> classDis(weights.begin(), weights.end());
+    std::exponential_distribution<> lifetimeDis(1.0 / meanLifetime);
+
+    struct Departure {
+        double time;
+        int serverId;
+        ResourceVector demand;
+        bool operator>(const Departure& other) const {
+            return time > other.time;
+        }
+    };
+    std::priority_queue<Departure, std::vector<Departure>, std::greater<Departure>> departures;
+
+    ResourceVector totalCapacity = {};
+    for (const auto& capacity : capacities) {
+        for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+            totalCapacity[resource] += capacity[resource];
+        }
+    }
+
+    int accepted = 0;
+    ResourceVector used = {};
+    ResourceVector usedTime = {};
+    // Statistics skip the first quarter of the arrivals, while the servers fill up
+    int warmup = numTasks / 4;
+    for (int taskId = 0; taskId < numTasks; ++taskId) {
+        double time = taskId;
+        while (!departures.empty() && departures.top().time <= time) {
+            const Departure& departure = departures.top();
+            servers.release(departure.serverId, departure.demand);
+            for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+                used[resource] -= departure.demand[resource];
+            }
+            departures.pop();
+        }
+        if (taskId >= warmup) {
+            for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+                usedTime[resource] += used[resource];
+            }
+        }
+
+        ResourceVector demand = generateDemand(classes, classDis, gen);
+        double lifetime = lifetimeDis(gen);
+        int serverId = selectServer<Policy>(servers, demand);
+        if (serverId < 0) {
+            continue;
+        }
+        servers.allocate(serverId, demand);
+        for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+            used[resource] += demand[resource];
+        }
+        departures.push({time + lifetime, serverId, demand});
+        if (taskId >= warmup) {
+            ++accepted;
+        }
+    }
+
+    PlacementResult result;
+    result.acceptedFraction = double(accepted) / (numTasks - warmup);
+    for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+        result.utilization[resource] = usedTime[resource] / (numTasks - warmup) / totalCapacity[resource];
+    }
+    return result;
+}
+
+// Helper function to time a selection function over a fixed server state; returns nanoseconds per
+// decision and a checksum of the chosen servers
+template <typename Function>
+double measureSelection(Function select, const std::vector<ResourceVector>& demands, uint64_t& checksum) {
+    checksum = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for (const auto& demand : demands) {
+        checksum = checksum * 31 + uint64_t(select(demand) + 1);
+    }
+    auto endTime = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(endTime - startTime).count() / demands.size();
+}
+
+// Helper function to print the placement quality of a policy
+template <typename Policy>
+void printPlacement(const std::vector<ResourceVector>& capacities, const std::vector<TaskClass>& classes, int numTasks,
+                    double meanLifetime, uint64_t seed) {
+    PlacementResult result = simulatePlacement<Policy>(capacities, classes, numTasks, meanLifetime, seed);
+    std::cout << std::setw(24) << Policy::NAME << std::setw(12) << result.acceptedFraction;
+    for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+        std::cout << std::setw(12) << result.utilization[resource];
+    }
+    std::cout << std::endl;
+}
+
+// Helper function to print the scalar and SIMD selection cost of a policy; returns whether both
+// picked the same servers
+template <typename Policy>
+bool printSelectionCost(const ServerResources& servers, const std::vector<ResourceVector>& demands,
+                        double baselineTime) {
+    uint64_t scalarChecksum, simdChecksum;
+    double scalarTime = measureSelection(
+        [&](const ResourceVector& demand) { return selectServerScalar<Policy>(servers, demand); }, demands,
+        scalarChecksum);
+    double simdTime = measureSelection(
+        [&](const ResourceVector& demand) { return selectServer<Policy>(servers, demand); }, demands, simdChecksum);
+    bool match = scalarChecksum == simdChecksum;
+    std::cout << std::setw(24) << Policy::NAME << std::setw(16) << scalarTime << std::setw(16) << simdTime
+              << std::setw(20) << simdTime / baselineTime << std::setw(12) << (match ? "match" : "MISMATCH")
+              << std::endl;
+    return match;
+}
+
+int main() {
+    const int NUM_SERVERS = 64;
+    const int NUM_TASKS = 200000;
+    const double MEAN_LIFETIME = 1000;
+    const int NUM_DECISIONS = 200000;
+    const uint64_t SEED = 42;
+
+    std::mt19937 gen(SEED);
+    std::vector<ResourceVector> capacities = generateCapacities(NUM_SERVERS, gen);
+    // CPU-bound, memory-bound and network-bound tasks; the lifetime puts the pool near saturation
+    std::vector<TaskClass> classes = {{{4, 4, 1}, 0.4}, {{1, 16, 1}, 0.3}, {{1, 4, 8}, 0.3}};
+
+    std::cout << "Online placement on " << NUM_SERVERS << " servers" << std::endl;
+    std::cout << std::setw(24) << "Placement Policy" << std::setw(12) << "Accepted";
+    for (const auto& name : RESOURCE_NAMES) {
+        std::cout << std::setw(12) << name;
+    }
+    std::cout << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    printPlacement<LeastLoadedPolicy>(capacities, classes, NUM_TASKS, MEAN_LIFETIME, SEED);
+    printPlacement<DotProductPolicy>(capacities, classes, NUM_TASKS, MEAN_LIFETIME, SEED);
+    printPlacement<BestFitPolicy>(capacities, classes, NUM_TASKS, MEAN_LIFETIME, SEED);
+    printPlacement<DominantResourcePolicy>(capacities, classes, NUM_TASKS, MEAN_LIFETIME, SEED);
+
+    bool consistent = true;
+    for (int numServers : {64, 1024}) {
+        // Score against a pool filled to about half of its capacity
+        std::vector<ResourceVector> poolCapacities = generateCapacities(numServers, gen);
+        ServerResources servers(poolCapacities);
+        std::vector<double> weights = {0.4, 0.3, 0.3};
+        std::discrete_distribution<> classDis(weights.begin(), weights.end());
+        std::uniform_int_distribution<> serverDis(0, numServers - 1);
+        std::vector<double> loads(numServers, 0.0);
+        for (int i = 0; i < numServers * 8; ++i) {
+            ResourceVector demand = generateDemand(classes, classDis, gen);
+            int serverId = serverDis(gen);
+            bool fits = true;
+            for (int resource = 0; resource < NUM_RESOURCES; ++resource) {
+                fits = fits && demand[resource] <= servers.getFree(serverId, resource);
+            }
+            if (fits) {
+                servers.allocate(serverId, demand);
+                loads[serverId] += demand[0];
+            }
+        }
+        std::vector<ResourceVector> demands(NUM_DECISIONS);
+        for (auto& demand : demands) {
+            demand = generateDemand(classes, classDis, gen);
+        }
+
+        // Today's balancers: a least-loaded scan over one scalar load per server, which then takes the task
+        uint64_t baselineChecksum;
+        double baselineTime = measureSelection(
+            [&](const ResourceVector& demand) {
+                double minLoad = loads[0];
+                int minLoadServer = 0;
+                for (int serverId = 1; serverId < numServers; ++serverId) {
+                    if (loads[serverId] < minLoad) {
+                        minLoad = loads[serverId];
+                        minLoadServer = serverId;
+                    }
+                }
+                loads[minLoadServer] += demand[0];
+                return minLoadServer;
+            },
+            demands, baselineChecksum);
+
+        std::cout << std::endl << "Selection cost on " << numServers << " servers (scalar load scan: " << baselineTime
+                  << " ns)" << std::endl;
+        std::cout << std::setw(24) << "Placement Policy" << std::setw(16) << "Scalar (ns)" << std::setw(16)
+                  << "SIMD (ns)" << std::setw(20) << "SIMD / Load Scan" << std::setw(12) << "Choices" << std::endl;
+        consistent &= printSelectionCost<LeastLoadedPolicy>(servers, demands, baselineTime);
+        consistent &= printSelectionCost<DotProductPolicy>(servers, demands, baselineTime);
+        consistent &= printSelectionCost<BestFitPolicy>(servers, demands, baselineTime);
+        consistent &= printSelectionCost<DominantResourcePolicy>(servers, demands, baselineTime);
+    }
+
+    return consistent ? 0 : 1;
+}
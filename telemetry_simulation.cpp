@@ -0,0 +1,622 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <bit>
+#include <string>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <time.h>
+#include <fmt/format.h>
+#include "tracing.h"
+
+// Server class: c parallel service slots of equal speed (an M/M/c station)
+class Server {
+public:
+    Server(int id, int slots, double slotSpeed) : id(id), slots(slots), slotSpeed(slotSpeed), time(0), queuedLoad(0) {
+        for (int slot = 0; slot < slots; ++slot) {
+            slotFreeTimes.push(0);
+        }
+    }
+
+    // Queues a task at the current time on the earliest free slot
+    void addLoad(double taskLoad) {
+        double startTime = std::max(time, slotFreeTimes.top());
+        slotFreeTimes.pop();
+        double completionTime = startTime + taskLoad / slotSpeed;
+        slotFreeTimes.push(completionTime);
+        loads.push({completionTime, taskLoad});
+        queuedLoad += taskLoad;
+    }
+
+    // Tasks in the system, in service or waiting
+    int getLoad() const {
+        return int(std::ssize(loads));
+    }
+
+    // Tasks beyond the busy slots; negative when slots are idle
+    int getBacklog() const {
+        return getLoad() - slots;
+    }
+
+    int getId() const {
+        return id;
+    }
+
+    double getCapability() const {
+        return slots * slotSpeed;
+    }
+
+    double getQueuedLoad() const {
+        return queuedLoad;
+    }
+
+    // Advances the server clock and retires every task finished by then
+    void update(double currentTime) {
+        time = currentTime;
+        while (!loads.empty()) {
+            if (loads.top().completionTime > time) break;
+            queuedLoad -= loads.top().taskLoad;
+            loads.pop();
+        }
+    }
+
+private:
+    struct QueuedTask {
+        double completionTime;
+        double taskLoad;
+
+        bool operator>(const QueuedTask& other) const {
+            return completionTime > other.completionTime;
+        }
+    };
+
+    int id;
+    int slots;
+    double slotSpeed;
+    double time;
+    double queuedLoad;
+    std::priority_queue<QueuedTask, std::vector<QueuedTask>, std::greater<>> loads;
+    std::priority_queue<double, std::vector<double>, std::greater<>> slotFreeTimes;
+};
+
+// Telemetry file layout: a header followed by blocks of samples. The header version selects the
+// block encoding.
+//
+// Version 1 (raw) blocks are columnar:
+//   uint32 numSamples | double time[numSamples] | float load[numSamples][numServers]
+//   | int32 queueLength[numSamples][numServers]
+//
+// Version 2 (Gorilla) blocks hold one compressed chunk per server, so a series can be read
+// without decoding the others:
+//   uint32 numSamples | double firstTime | double lastTime | uint32 chunkBytes[numServers] | chunks
+// and the file ends with an index for random access by time range:
+//   { double firstTime | double lastTime | uint64 blockOffset }[numBlocks] | uint64 numBlocks | "LBTI"
+//
+// load is the queued work per unit of capability and queueLength the tasks in the system.
+struct TelemetryHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t numServers;
+    uint32_t samplesPerBlock;
+};
+
+enum class TelemetryEncoding : uint32_t {
+    Raw = 1,
+    Gorilla = 2
+};
+
+// Bit stream writer, most significant bit first
+class BitWriter {
+public:
+    void writeBits(uint64_t value, int numBits) {
+        while (numBits > 0) {
+            if (bitPosition == 0) {
+                bytes.push_back(0);
+            }
+            int space = 8 - bitPosition;
+            int take = std::min(space, numBits);
+            uint8_t bits = (value >> (numBits - take)) & ((1u << take) - 1);
+            bytes.back() |= bits << (space - take);
+            bitPosition = (bitPosition + take) % 8;
+            numBits -= take;
+        }
+    }
+
+    const std::vector<uint8_t>& getBytes() const {
+        return bytes;
+    }
+
+private:
+    std::vector<uint8_t> bytes;
+    int bitPosition = 0;
+};
+
+// Gorilla-style series encoder: delta-of-delta timestamps, XOR-compressed float loads and
+// delta-encoded queue lengths. Timestamps are kept in 1/TIME_RESOLUTION units of simulated time.
+// Loads may be rounded to nearest at fewer mantissa bits, which lengthens the runs of zero XOR bits;
+// with m bits kept the relative error is at most 2^-(m + 1).
+class GorillaEncoder {
+public:
+    static constexpr double TIME_RESOLUTION = 1000.0;
+
+    GorillaEncoder(int mantissaBits = 23)
+        : mantissaMask(~((uint32_t(1) << (23 - mantissaBits)) - 1)), roundingBias((~mantissaMask + 1) >> 1) {}
+
+    void append(double time, float load, int32_t queueLength) {
+        int64_t timestamp = std::llround(time * TIME_RESOLUTION);
+        // Adding half a kept ULP before masking rounds to nearest; a carry into the exponent is the
+        // correctly rounded next power of two
+        uint32_t loadBits = (std::bit_cast<uint32_t>(load) + roundingBias) & mantissaMask;
+        if (numSamples == 0) {
+            writer.writeBits(uint64_t(timestamp), 64);
+            writer.writeBits(loadBits, 32);
+            writer.writeBits(uint32_t(queueLength), 32);
+        } else {
+            int64_t delta = timestamp - previousTimestamp;
+            writeVarying(delta - previousDelta);
+            writeXor(loadBits ^ previousLoadBits);
+            writeVarying(int64_t(queueLength) - previousQueueLength);
+            previousDelta = delta;
+        }
+        previousTimestamp = timestamp;
+        previousLoadBits = loadBits;
+        previousQueueLength = queueLength;
+        ++numSamples;
+    }
+
+    const std::vector<uint8_t>& getBytes() const {
+        return writer.getBytes();
+    }
+
+private:
+    BitWriter writer;
+    uint32_t mantissaMask;
+    uint32_t roundingBias; // Half of the lowest kept mantissa bit
+    int numSamples = 0;
+    int64_t previousTimestamp = 0;
+    int64_t previousDelta = 0;
+    uint32_t previousLoadBits = 0;
+    int32_t previousQueueLength = 0;
+    int previousLeading = -1;
+    int previousTrailing = 0;
+
+    // Small signed integers in a prefix-coded bucket: 0, then 7, 9, 12 or 64 bits
+    void writeVarying(int64_t value) {
+        if (value == 0) {
+            writer.writeBits(0b0, 1);
+        } else if (value >= -63 && value <= 64) {
+            writer.writeBits(0b10, 2);
+            writer.writeBits(uint64_t(value + 63), 7);
+        } else if (value >= -255 && value <= 256) {
+            writer.writeBits(0b110, 3);
+            writer.writeBits(uint64_t(value + 255), 9);
+        } else if (value >= -2047 && value <= 2048) {
+            writer.writeBits(0b1110, 4);
+            writer.writeBits(uint64_t(value + 2047), 12);
+        } else {
+            writer.writeBits(0b1111, 4);
+            writer.writeBits(uint64_t(value), 64);
+        }
+    }
+
+    // XOR with the previous value: reuse the previous meaningful-bit window when it still fits
+    void writeXor(uint32_t xorBits) {
+        if (xorBits == 0) {
+            writer.writeBits(0b0, 1);
+            return;
+        }
+        int leading = std::countl_zero(xorBits);
+        int trailing = std::countr_zero(xorBits);
+        if (previousLeading >= 0 && leading >= previousLeading && trailing >= previousTrailing) {
+            writer.writeBits(0b10, 2);
+            writer.writeBits(xorBits >> previousTrailing, 32 - previousLeading - previousTrailing);
+        } else {
+            int meaningful = 32 - leading - trailing;
+            writer.writeBits(0b11, 2);
+            writer.writeBits(leading, 5);
+            writer.writeBits(meaningful - 1, 5);
+            writer.writeBits(xorBits >> trailing, meaningful);
+            previousLeading = leading;
+            previousTrailing = trailing;
+        }
+    }
+};
+
+// Telemetry sink: samples are appended to a front buffer while a background thread encodes and
+// writes the back buffer, so the simulation thread never waits on the file unless the writer
+// falls behind. The simulation thread pays only for record (copying one sample, and waiting when
+// the writer is a block behind); encoding costs writer CPU time, which is free only when a core
+// is spare. On a single core it lands in the simulation's wall time as well, so the sink reports
+// the two separately.
+class TelemetrySink {
+public:
+    TelemetrySink(const std::string& path, int numServers, TelemetryEncoding encoding = TelemetryEncoding::Raw,
+                  int mantissaBits = 23, int samplesPerBlock = 128)
+        : numServers(numServers), samplesPerBlock(samplesPerBlock), encoding(encoding), mantissaBits(mantissaBits),
+          file(std::fopen(path.c_str(), "wb")), backPending(false), stopping(false) {
+        if (!file) {
+            throw std::runtime_error("cannot open telemetry file " + path);
+        }
+        TelemetryHeader header = {{'L', 'B', 'T', 'S'}, uint32_t(encoding), uint32_t(numServers),
+                                  uint32_t(samplesPerBlock)};
+        std::fwrite(&header, sizeof(header), 1, file);
+
+        front.reserve(numServers, samplesPerBlock);
+        back.reserve(numServers, samplesPerBlock);
+        writer = std::thread(&TelemetrySink::writeLoop, this);
+    }
+
+    ~TelemetrySink() {
+        if (file) {
+            close();
+        }
+    }
+
+    // Flushes the partially filled front buffer and stops the writer thread
+    void close() {
+        if (!front.times.empty()) {
+            swapBuffers();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        writer.join();
+
+        if (encoding == TelemetryEncoding::Gorilla) {
+            uint64_t numBlocks = blockIndex.size();
+            std::fwrite(blockIndex.data(), sizeof(BlockIndexEntry), blockIndex.size(), file);
+            std::fwrite(&numBlocks, sizeof(numBlocks), 1, file);
+            std::fwrite("LBTI", 1, 4, file);
+            bytesWritten += blockIndex.size() * sizeof(BlockIndexEntry) + sizeof(numBlocks) + 4;
+        }
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    void record(double time, const std::vector<Server>& servers) {
+        auto startTime = std::chrono::steady_clock::now();
+        size_t numServers = servers.size();
+        size_t offset = front.times.size() * numServers;
+        front.times.push_back(time);
+        front.loads.resize(offset + numServers);
+        front.queueLengths.resize(offset + numServers);
+
+        float* loads = front.loads.data() + offset;
+        int32_t* queueLengths = front.queueLengths.data() + offset;
+        for (size_t serverId = 0; serverId < numServers; ++serverId) {
+            loads[serverId] = float(servers[serverId].getQueuedLoad() / servers[serverId].getCapability());
+            queueLengths[serverId] = servers[serverId].getLoad();
+        }
+        if (int(front.times.size()) == samplesPerBlock) {
+            swapBuffers();
+        }
+        recordTime += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    long long getBytesWritten() const {
+        return bytesWritten;
+    }
+
+    // Wall time the simulation thread spent in record, in microseconds
+    double getRecordTime() const {
+        return recordTime;
+    }
+
+    // CPU time the writer thread spent encoding and writing blocks, in microseconds; valid after close
+    double getWriterTime() const {
+        return writerTime;
+    }
+
+private:
+    struct Buffer {
+        std::vector<double> times;
+        std::vector<float> loads;
+        std::vector<int32_t> queueLengths;
+
+        void reserve(int numServers, int samplesPerBlock) {
+            times.reserve(samplesPerBlock);
+            loads.reserve(size_t(numServers) * samplesPerBlock);
+            queueLengths.reserve(size_t(numServers) * samplesPerBlock);
+        }
+
+        void clear() {
+            times.clear();
+            loads.clear();
+            queueLengths.clear();
+        }
+    };
+
+    struct BlockIndexEntry {
+        double firstTime;
+        double lastTime;
+        uint64_t blockOffset;
+    };
+
+    int numServers;
+    int samplesPerBlock;
+    TelemetryEncoding encoding;
+    int mantissaBits;
+    std::FILE* file;
+    std::vector<BlockIndexEntry> blockIndex;
+    Buffer front;
+    Buffer back;
+    bool backPending;
+    bool stopping;
+    long long bytesWritten = sizeof(TelemetryHeader);
+    double recordTime = 0;
+    double writerTime = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread writer;
+
+    // Hands the front buffer to the writer, waiting only if the previous block is still being written
+    void swapBuffers() {
+        TRACE_SCOPE("telemetry.swapBuffers");
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return !backPending; });
+        std::swap(front, back);
+        backPending = true;
+        lock.unlock();
+        cv.notify_all();
+    }
+
+    void writeRawBlock() {
+        uint32_t numSamples = back.times.size();
+        std::fwrite(&numSamples, sizeof(numSamples), 1, file);
+        std::fwrite(back.times.data(), sizeof(double), back.times.size(), file);
+        std::fwrite(back.loads.data(), sizeof(float), back.loads.size(), file);
+        std::fwrite(back.queueLengths.data(), sizeof(int32_t), back.queueLengths.size(), file);
+        bytesWritten += sizeof(numSamples) + back.times.size() * sizeof(double) +
+                        back.loads.size() * sizeof(float) + back.queueLengths.size() * sizeof(int32_t);
+    }
+
+    void writeGorillaBlock() {
+        uint32_t numSamples = back.times.size();
+        std::vector<GorillaEncoder> encoders(numServers, GorillaEncoder(mantissaBits));
+        for (uint32_t sample = 0; sample < numSamples; ++sample) {
+            size_t offset = size_t(sample) * numServers;
+            for (int serverId = 0; serverId < numServers; ++serverId) {
+                encoders[serverId].append(back.times[sample], back.loads[offset + serverId],
+                                          back.queueLengths[offset + serverId]);
+            }
+        }
+
+        std::vector<uint32_t> chunkBytes(numServers);
+        for (int serverId = 0; serverId < numServers; ++serverId) {
+            chunkBytes[serverId] = encoders[serverId].getBytes().size();
+        }
+        blockIndex.push_back({back.times.front(), back.times.back(), uint64_t(bytesWritten)});
+
+        std::fwrite(&numSamples, sizeof(numSamples), 1, file);
+        std::fwrite(&back.times.front(), sizeof(double), 1, file);
+        std::fwrite(&back.times.back(), sizeof(double), 1, file);
+        std::fwrite(chunkBytes.data(), sizeof(uint32_t), chunkBytes.size(), file);
+        bytesWritten += sizeof(numSamples) + 2 * sizeof(double) + chunkBytes.size() * sizeof(uint32_t);
+        for (const auto& encoder : encoders) {
+            std::fwrite(encoder.getBytes().data(), 1, encoder.getBytes().size(), file);
+            bytesWritten += encoder.getBytes().size();
+        }
+    }
+
+    // CPU time of the calling thread in microseconds
+    static double getThreadCpuTime() {
+        timespec now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return now.tv_sec * 1e6 + now.tv_nsec / 1e3;
+    }
+
+    void writeLoop() {
+        if (tracing::Tracer::get().isEnabled()) {
+            tracing::Tracer::get().setThreadName("Telemetry Writer");
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cv.wait(lock, [this] { return backPending || stopping; });
+            if (!backPending) {
+                return;
+            }
+
+            // The simulation thread only touches the front buffer, so the write can run unlocked
+            lock.unlock();
+            {
+                TRACE_SCOPE("telemetry.writeBlock", int(back.times.size()));
+                double startTime = getThreadCpuTime();
+                if (encoding == TelemetryEncoding::Gorilla) {
+                    writeGorillaBlock();
+                } else {
+                    writeRawBlock();
+                }
+                writerTime += getThreadCpuTime() - startTime;
+            }
+            back.clear();
+            lock.lock();
+
+            backPending = false;
+            cv.notify_all();
+        }
+    }
+};
+
+// Load Balancer class
+template <typename LoadBalancingAlgorithm>
+class LoadBalancer {
+public:
+    LoadBalancer(const std::vector<int>& capabilities, double slotSpeed) : simulatedTime(0), algorithm(servers) {
+        int numServers = capabilities.size();
+        // Initialize servers
+        servers.reserve(numServers);
+        for (int i = 0; i < numServers; ++i) {
+            servers.push_back(Server(i, capabilities[i], slotSpeed));
+        }
+    }
+
+    // Feeds arrivalRate tasks per unit of time; when a sink is given, samples every server each
+    // sampleInterval units of time
+    void simulate(const std::vector<double>& taskLoads, int arrivalRate, TelemetrySink* telemetry = nullptr,
+                  double sampleInterval = 1.0) {
+        double nextSample = simulatedTime;
+        for (size_t first = 0; first < taskLoads.size(); first += arrivalRate) {
+            TRACE_SCOPE("simulation.tick", int(simulatedTime));
+            simulatedTime += 1.0;
+            {
+                TRACE_SCOPE("simulation.updateServers");
+                for (auto& server : servers) {
+                    server.update(simulatedTime);
+                }
+            }
+            size_t last = std::min(taskLoads.size(), first + arrivalRate);
+            {
+                TRACE_SCOPE("dispatch.batch", int(last - first));
+                algorithm.balanceLoad(std::vector<double>(taskLoads.begin() + first, taskLoads.begin() + last));
+            }
+
+            if (telemetry && simulatedTime >= nextSample) {
+                TRACE_SCOPE("telemetry.record");
+                telemetry->record(simulatedTime, servers);
+                nextSample += sampleInterval;
+            }
+        }
+    }
+
+private:
+    double simulatedTime;
+    std::vector<Server> servers;
+    LoadBalancingAlgorithm algorithm;
+};
+
+// Power-of-two-choices algorithm (JSQ(2) on the backlog)
+class PowerOfTwoChoicesLoadBalancing {
+public:
+    PowerOfTwoChoicesLoadBalancing(std::vector<Server>& servers) : servers(servers), gen(std::random_device{}()) {}
+
+    void balanceLoad(const std::vector<double>& taskLoads) {
+        std::uniform_int_distribution<> dis(0, servers.size() - 1);
+
+        for (const auto& taskLoad : taskLoads) {
+            int first = dis(gen);
+            int second = dis(gen);
+            servers[servers[second].getBacklog() < servers[first].getBacklog() ? second : first].addLoad(taskLoad);
+        }
+    }
+
+private:
+    std::vector<Server>& servers;
+    std::mt19937 gen;
+};
+
+// Helper function to generate random task loads
+std::vector<double> generateRandomTaskLoads(int numTasks) {
+    std::vector<double> taskLoads(numTasks);
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> dis(1.0, 10.0);
+    for (int i = 0; i < numTasks; ++i) {
+        taskLoads[i] = dis(gen);
+    }
+    return taskLoads;
+}
+
+// Helper function to generate random capabilities for servers
+std::vector<int> generateRandomCapabilities(int numServers, int minCapability, int maxCapability) {
+    std::vector<int> capabilities(numServers);
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> dis(minCapability, maxCapability);
+    for (int i = 0; i < numServers; ++i) {
+        capabilities[i] = dis(gen);
+    }
+    return capabilities;
+}
+
+// Helper function to time one simulation, with or without telemetry
+double timeSimulation(const std::vector<int>& capabilities, const std::vector<double>& taskLoads, int arrivalRate,
+                      double slotSpeed, TelemetrySink* telemetry) {
+    LoadBalancer<PowerOfTwoChoicesLoadBalancing> balancer(capabilities, slotSpeed);
+    auto startTime = std::chrono::steady_clock::now();
+    balancer.simulate(taskLoads, arrivalRate, telemetry);
+    auto endTime = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+}
+
+int main(int argc, char** argv) {
+    const int NUM_SERVERS = 10000;
+    const int MIN_CAPABILITY = 1;
+    const int MAX_CAPABILITY = 16;
+    const double SLOT_SPEED = 1.0;
+    const double MEAN_TASK_LOAD = 5.5;
+    const double OFFERED_LOAD = 0.9;
+    const int NUM_TICKS = 200;
+    std::string prefix = argc > 1 ? argv[1] : "telemetry";
+    // Optional Chrome trace of the runs, showing the simulation thread against the telemetry writer
+    std::string tracePath = argc > 2 ? argv[2] : "";
+    if (!tracePath.empty()) {
+        tracing::Tracer::get().start(tracePath);
+        tracing::Tracer::get().setThreadName("Simulation");
+    }
+
+    std::vector<int> capabilities = generateRandomCapabilities(NUM_SERVERS, MIN_CAPABILITY, MAX_CAPABILITY);
+    double totalCapability = 0.0;
+    for (const auto& capability : capabilities) {
+        totalCapability += capability * SLOT_SPEED;
+    }
+    int arrivalRate = std::max(1, int(std::lround(OFFERED_LOAD * totalCapability / MEAN_TASK_LOAD)));
+    std::vector<double> taskLoads = generateRandomTaskLoads(arrivalRate * NUM_TICKS);
+
+    double baseline = timeSimulation(capabilities, taskLoads, arrivalRate, SLOT_SPEED, nullptr);
+
+    // Raw, lossless Gorilla and Gorilla with loads rounded to 8 mantissa bits (at most 0.2% error)
+    std::vector<std::string> sinks = {"Raw", "Gorilla", "Gorilla (8-bit mantissa)"};
+    std::vector<std::string> paths = {prefix + ".raw.bin", prefix + ".gorilla.bin", prefix + ".gorilla8.bin"};
+    std::vector<TelemetryEncoding> encodings = {TelemetryEncoding::Raw, TelemetryEncoding::Gorilla,
+                                                TelemetryEncoding::Gorilla};
+    std::vector<int> mantissaBits = {23, 23, 8};
+
+    std::cout << std::setw(28) << "Num Servers" << std::setw(20) << NUM_SERVERS << std::endl;
+    std::cout << std::setw(28) << "Samples" << std::setw(20) << NUM_TICKS << std::endl;
+    std::cout << std::setw(28) << "Without Telemetry (μs)" << std::setw(20) << baseline << std::endl;
+    std::cout << std::endl;
+
+    // Overhead is against the run without telemetry; Record is what the simulation thread itself
+    // spent sampling, and Writer CPU what encoding cost on the background thread
+    std::cout << std::setw(28) << "Telemetry Sink" << std::setw(20) << "Execution Time (μs)" << std::setw(16)
+              << "Overhead (%)" << std::setw(16) << "Record (μs)" << std::setw(20) << "Writer CPU (μs)"
+              << std::setw(16) << "Bytes" << std::setw(16) << "Ratio" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    long long rawBytes = 0;
+    for (size_t i = 0; i < sinks.size(); ++i) {
+        TelemetrySink telemetry(paths[i], NUM_SERVERS, encodings[i], mantissaBits[i]);
+        double withTelemetry = timeSimulation(capabilities, taskLoads, arrivalRate, SLOT_SPEED, &telemetry);
+        telemetry.close();
+        if (i == 0) {
+            rawBytes = telemetry.getBytesWritten();
+        }
+
+        std::cout << std::setw(28) << sinks[i] << std::setw(20) << withTelemetry << std::setw(16)
+                  << (withTelemetry - baseline) / baseline * 100.0 << std::setw(16) << telemetry.getRecordTime()
+                  << std::setw(20) << telemetry.getWriterTime() << std::setw(16) << telemetry.getBytesWritten()
+                  << std::setw(16) << double(rawBytes) / telemetry.getBytesWritten() << std::endl;
+    }
+
+    if (!tracePath.empty()) {
+        tracing::Tracer::get().stop();
+        std::cout << std::endl;
+        std::cout << std::setw(28) << "Trace Events" << std::setw(20) << tracing::Tracer::get().getNumEvents()
+                  << std::endl;
+        std::cout << std::setw(28) << "Dropped Events" << std::setw(20) << tracing::Tracer::get().getDropped()
+                  << std::endl;
+    }
+
+    return 0;
+}
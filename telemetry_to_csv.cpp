@@ -0,0 +1,264 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <bit>
+#include <fmt/format.h>
+
+// Telemetry file layout written by telemetry_simulation: a header followed by blocks of samples.
+// The header version selects the block encoding.
+//
+// Version 1 (raw) blocks are columnar:
+//   uint32 numSamples | double time[numSamples] | float load[numSamples][numServers]
+//   | int32 queueLength[numSamples][numServers]
+//
+// Version 2 (Gorilla) blocks hold one compressed chunk per server:
+//   uint32 numSamples | double firstTime | double lastTime | uint32 chunkBytes[numServers] | chunks
+// and the file ends with an index for random access by time range:
+//   { double firstTime | double lastTime | uint64 blockOffset }[numBlocks] | uint64 numBlocks | "LBTI"
+struct TelemetryHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t numServers;
+    uint32_t samplesPerBlock;
+};
+
+struct BlockIndexEntry {
+    double firstTime;
+    double lastTime;
+    uint64_t blockOffset;
+};
+
+// Bit stream reader, most significant bit first
+class BitReader {
+public:
+    BitReader(const uint8_t* bytes) : bytes(bytes), position(0) {}
+
+    uint64_t readBits(int numBits) {
+        uint64_t value = 0;
+        while (numBits > 0) {
+            int bitPosition = position % 8;
+            int space = 8 - bitPosition;
+            int take = std::min(space, numBits);
+            uint8_t bits = (bytes[position / 8] >> (space - take)) & ((1u << take) - 1);
+            value = (value << take) | bits;
+            position += take;
+            numBits -= take;
+        }
+        return value;
+    }
+
+private:
+    const uint8_t* bytes;
+    size_t position;
+};
+
+// Decoder for the series chunks written by GorillaEncoder in telemetry_simulation
+class GorillaDecoder {
+public:
+    static constexpr double TIME_RESOLUTION = 1000.0;
+
+    GorillaDecoder(const uint8_t* bytes) : reader(bytes) {}
+
+    void next(double& time, float& load, int32_t& queueLength) {
+        if (numSamples == 0) {
+            previousTimestamp = int64_t(reader.readBits(64));
+            previousLoadBits = uint32_t(reader.readBits(32));
+            previousQueueLength = int32_t(reader.readBits(32));
+        } else {
+            previousDelta += readVarying();
+            previousTimestamp += previousDelta;
+            previousLoadBits ^= readXor();
+            previousQueueLength += int32_t(readVarying());
+        }
+        ++numSamples;
+        time = previousTimestamp / TIME_RESOLUTION;
+        load = std::bit_cast<float>(previousLoadBits);
+        queueLength = previousQueueLength;
+    }
+
+private:
+    BitReader reader;
+    int numSamples = 0;
+    int64_t previousTimestamp = 0;
+    int64_t previousDelta = 0;
+    uint32_t previousLoadBits = 0;
+    int32_t previousQueueLength = 0;
+    int previousLeading = 0;
+    int previousTrailing = 0;
+
+    int64_t readVarying() {
+        if (reader.readBits(1) == 0) {
+            return 0;
+        }
+        if (reader.readBits(1) == 0) {
+            return int64_t(reader.readBits(7)) - 63;
+        }
+        if (reader.readBits(1) == 0) {
+            return int64_t(reader.readBits(9)) - 255;
+        }
+        if (reader.readBits(1) == 0) {
+            return int64_t(reader.readBits(12)) - 2047;
+        }
+        return int64_t(reader.readBits(64));
+    }
+
+    uint32_t readXor() {
+        if (reader.readBits(1) == 0) {
+            return 0;
+        }
+        if (reader.readBits(1) == 1) {
+            previousLeading = int(reader.readBits(5));
+            int meaningful = int(reader.readBits(5)) + 1;
+            previousTrailing = 32 - previousLeading - meaningful;
+        }
+        int meaningful = 32 - previousLeading - previousTrailing;
+        return uint32_t(reader.readBits(meaningful)) << previousTrailing;
+    }
+};
+
+// Helper function to export raw blocks; samples outside [fromTime, toTime] are skipped
+bool exportRaw(std::FILE* input, std::FILE* output, const TelemetryHeader& header, double fromTime, double toTime) {
+    std::vector<double> times;
+    std::vector<float> loads;
+    std::vector<int32_t> queueLengths;
+
+    uint32_t numSamples;
+    while (std::fread(&numSamples, sizeof(numSamples), 1, input) == 1) {
+        size_t numValues = size_t(numSamples) * header.numServers;
+        times.resize(numSamples);
+        loads.resize(numValues);
+        queueLengths.resize(numValues);
+        if (std::fread(times.data(), sizeof(double), numSamples, input) != numSamples ||
+            std::fread(loads.data(), sizeof(float), numValues, input) != numValues ||
+            std::fread(queueLengths.data(), sizeof(int32_t), numValues, input) != numValues) {
+            return false;
+        }
+
+        for (uint32_t sample = 0; sample < numSamples; ++sample) {
+            if (times[sample] < fromTime || times[sample] > toTime) continue;
+            for (uint32_t serverId = 0; serverId < header.numServers; ++serverId) {
+                size_t index = size_t(sample) * header.numServers + serverId;
+                std::fprintf(output, "%g,%u,%g,%d\n", times[sample], serverId, loads[index], queueLengths[index]);
+            }
+        }
+    }
+    return true;
+}
+
+// Helper function to export Gorilla blocks; only blocks overlapping [fromTime, toTime] are read
+bool exportGorilla(std::FILE* input, std::FILE* output, const TelemetryHeader& header, double fromTime, double toTime) {
+    uint64_t numBlocks;
+    char magic[4];
+    if (std::fseek(input, -long(sizeof(numBlocks) + sizeof(magic)), SEEK_END) != 0 ||
+        std::fread(&numBlocks, sizeof(numBlocks), 1, input) != 1 || std::fread(magic, 1, 4, input) != 4 ||
+        std::memcmp(magic, "LBTI", 4) != 0) {
+        return false;
+    }
+    std::vector<BlockIndexEntry> blockIndex(numBlocks);
+    long indexOffset = -long(sizeof(numBlocks) + sizeof(magic) + numBlocks * sizeof(BlockIndexEntry));
+    if (std::fseek(input, indexOffset, SEEK_END) != 0 ||
+        std::fread(blockIndex.data(), sizeof(BlockIndexEntry), numBlocks, input) != numBlocks) {
+        return false;
+    }
+
+    std::vector<uint32_t> chunkBytes(header.numServers);
+    std::vector<uint8_t> chunks;
+    std::vector<double> times;
+    std::vector<float> loads;
+    std::vector<int32_t> queueLengths;
+    for (const auto& block : blockIndex) {
+        if (block.lastTime < fromTime || block.firstTime > toTime) continue;
+
+        uint32_t numSamples;
+        double firstTime, lastTime;
+        if (std::fseek(input, long(block.blockOffset), SEEK_SET) != 0 ||
+            std::fread(&numSamples, sizeof(numSamples), 1, input) != 1 ||
+            std::fread(&firstTime, sizeof(double), 1, input) != 1 ||
+            std::fread(&lastTime, sizeof(double), 1, input) != 1 ||
+            std::fread(chunkBytes.data(), sizeof(uint32_t), header.numServers, input) != header.numServers) {
+            return false;
+        }
+        size_t totalBytes = 0;
+        for (const auto& bytes : chunkBytes) {
+            totalBytes += bytes;
+        }
+        // Padding lets the bit reader look one byte past the end of the last chunk
+        chunks.assign(totalBytes + 8, 0);
+        if (std::fread(chunks.data(), 1, totalBytes, input) != totalBytes) {
+            return false;
+        }
+
+        // Decode every series, then emit rows time-major like the raw export
+        size_t numValues = size_t(numSamples) * header.numServers;
+        times.resize(numSamples);
+        loads.resize(numValues);
+        queueLengths.resize(numValues);
+        size_t chunkOffset = 0;
+        for (uint32_t serverId = 0; serverId < header.numServers; ++serverId) {
+            GorillaDecoder decoder(chunks.data() + chunkOffset);
+            for (uint32_t sample = 0; sample < numSamples; ++sample) {
+                size_t index = size_t(sample) * header.numServers + serverId;
+                decoder.next(times[sample], loads[index], queueLengths[index]);
+            }
+            chunkOffset += chunkBytes[serverId];
+        }
+
+        for (uint32_t sample = 0; sample < numSamples; ++sample) {
+            if (times[sample] < fromTime || times[sample] > toTime) continue;
+            for (uint32_t serverId = 0; serverId < header.numServers; ++serverId) {
+                size_t index = size_t(sample) * header.numServers + serverId;
+                std::fprintf(output, "%g,%u,%g,%d\n", times[sample], serverId, loads[index], queueLengths[index]);
+            }
+        }
+    }
+    return true;
+}
+
+// Exports a telemetry file as CSV rows of (time, server, load, queue_length), optionally limited to
+// the samples taken between fromTime and toTime
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <telemetry.bin> [output.csv] [fromTime toTime]" << std::endl;
+        return 1;
+    }
+    double fromTime = argc > 4 ? std::stod(argv[3]) : -INFINITY;
+    double toTime = argc > 4 ? std::stod(argv[4]) : INFINITY;
+
+    std::FILE* input = std::fopen(argv[1], "rb");
+    if (!input) {
+        std::cerr << "cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+    bool toStdout = argc < 3 || std::string(argv[2]) == "-";
+    std::FILE* output = toStdout ? stdout : std::fopen(argv[2], "w");
+    if (!output) {
+        std::cerr << "cannot open " << argv[2] << std::endl;
+        return 1;
+    }
+
+    TelemetryHeader header;
+    if (std::fread(&header, sizeof(header), 1, input) != 1 || std::memcmp(header.magic, "LBTS", 4) != 0 ||
+        (header.version != 1 && header.version != 2)) {
+        std::cerr << argv[1] << " is not a telemetry file" << std::endl;
+        return 1;
+    }
+
+    std::fprintf(output, "time,server,load,queue_length\n");
+    bool complete = header.version == 1 ? exportRaw(input, output, header, fromTime, toTime)
+                                        : exportGorilla(input, output, header, fromTime, toTime);
+    if (!complete) {
+        std::cerr << argv[1] << " is truncated" << std::endl;
+        return 1;
+    }
+
+    std::fclose(input);
+    if (!toStdout) {
+        std::fclose(output);
+    }
+
+    return 0;
+}
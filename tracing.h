@@ -0,0 +1,300 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "profiling.h"
+
+// Timeline tracing to Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev). Each thread
+// appends compact binary events to its own single-producer single-consumer ring; a background
+// writer drains every ring about once a millisecond and formats the JSON, so recording an event is
+// a TSC read and a few stores with no locks, allocation or formatting. A full ring drops the event
+// and counts it rather than stalling the traced thread. Nothing is recorded until start().
+namespace tracing {
+
+// One complete ("X") or instant ("i") event in TSC ticks
+struct TraceEvent {
+    uint64_t start;
+    uint64_t duration;
+    uint32_t nameId;
+    int32_t value;     // Shown as args.value; INT32_MIN for none
+};
+
+constexpr int32_t NO_VALUE = INT32_MIN;
+constexpr uint64_t INSTANT = UINT64_MAX;
+
+// Lock-free SPSC ring: the owning thread pushes, the writer pops. Each side caches the other's
+// index and rereads it only when the ring looks full or empty.
+class TraceRing {
+public:
+    static constexpr size_t CAPACITY = 1 << 16;
+
+    TraceRing(int threadId, std::string threadName)
+        : threadId(threadId), threadName(std::move(threadName)), events(CAPACITY) {}
+
+    bool push(const TraceEvent& event) {
+        uint64_t head = producer.head.load(std::memory_order_relaxed);
+        if (head - producer.cachedTail == CAPACITY) {
+            producer.cachedTail = consumer.tail.load(std::memory_order_acquire);
+            if (head - producer.cachedTail == CAPACITY) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        events[head & (CAPACITY - 1)] = event;
+        producer.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Hands every pending event to the consumer function; returns how many there were
+    template <typename Function>
+    size_t drain(Function function) {
+        uint64_t tail = consumer.tail.load(std::memory_order_relaxed);
+        uint64_t head = producer.head.load(std::memory_order_acquire);
+        for (uint64_t i = tail; i < head; ++i) {
+            function(events[i & (CAPACITY - 1)]);
+        }
+        consumer.tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    int getThreadId() const {
+        return threadId;
+    }
+
+    const std::string& getThreadName() const {
+        return threadName;
+    }
+
+    void setThreadName(std::string name) {
+        threadName = std::move(name);
+    }
+
+    uint64_t getDropped() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(64) ProducerSide {
+        std::atomic<uint64_t> head{0};
+        uint64_t cachedTail = 0;
+    };
+
+    struct alignas(64) ConsumerSide {
+        std::atomic<uint64_t> tail{0};
+    };
+
+    int threadId;
+    std::string threadName;
+    std::vector<TraceEvent> events;
+    ProducerSide producer;
+    ConsumerSide consumer;
+    std::atomic<uint64_t> dropped{0};
+};
+
+class Tracer {
+public:
+    static Tracer& get() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    ~Tracer() {
+        stop();
+    }
+
+    // Opens the trace file and starts the writer; events recorded before this are ignored
+    void start(const std::string& path) {
+        if (enabled.load()) {
+            throw std::runtime_error("Tracing already started");
+        }
+        file = std::fopen(path.c_str(), "w");
+        if (!file) {
+            throw std::runtime_error("cannot open trace file " + path);
+        }
+        std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+        firstEvent = true;
+        numEvents = 0;
+        ticksPerMicrosecond = profiling::getTimestampFrequency() / 1e6;
+        originTimestamp = profiling::readTimestamp();
+        stopping = false;
+        writer = std::thread(&Tracer::writeLoop, this);
+        enabled.store(true);
+    }
+
+    // Stops recording, drains every ring and closes the file
+    void stop() {
+        if (!enabled.exchange(false)) {
+            return;
+        }
+        stopping = true;
+        writer.join();
+        drainAll();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& ring : rings) {
+                writeSeparator();
+                std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                             ring->getThreadId(), ring->getThreadName().c_str());
+            }
+        }
+        std::fputs("\n]}\n", file);
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    bool isEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    uint32_t getNameId(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name) {
+                return i;
+            }
+        }
+        names.push_back(name);
+        return names.size() - 1;
+    }
+
+    // The calling thread's ring, created on first use
+    TraceRing& getRing() {
+        static thread_local std::shared_ptr<TraceRing> ring = registerRing();
+        return *ring;
+    }
+
+    // Labels the calling thread's track in the timeline
+    void setThreadName(const std::string& name) {
+        TraceRing& ring = getRing();
+        std::lock_guard<std::mutex> lock(mutex);
+        ring.setThreadName(name);
+    }
+
+    long long getNumEvents() const {
+        return numEvents;
+    }
+
+    uint64_t getDropped() {
+        std::lock_guard<std::mutex> lock(mutex);
+        uint64_t dropped = 0;
+        for (const auto& ring : rings) {
+            dropped += ring->getDropped();
+        }
+        return dropped;
+    }
+
+private:
+    std::mutex mutex;
+    // Rings outlive their threads so the writer can drain events of threads that already exited
+    std::vector<std::shared_ptr<TraceRing>> rings;
+    std::vector<std::string> names;
+    std::atomic<bool> enabled{false};
+    std::atomic<bool> stopping{false};
+    std::thread writer;
+    std::FILE* file = nullptr;
+    bool firstEvent = true;
+    long long numEvents = 0;
+    double ticksPerMicrosecond = 1;
+    uint64_t originTimestamp = 0;
+
+    std::shared_ptr<TraceRing> registerRing() {
+        std::lock_guard<std::mutex> lock(mutex);
+        int threadId = rings.size() + 1;
+        rings.push_back(std::make_shared<TraceRing>(threadId, "Thread " + std::to_string(threadId)));
+        return rings.back();
+    }
+
+    void writeSeparator() {
+        std::fputs(firstEvent ? "" : ",\n", file);
+        firstEvent = false;
+    }
+
+    void writeEvent(int threadId, const TraceEvent& event) {
+        // Events stamped before start() would land at negative times
+        if (event.start < originTimestamp) {
+            return;
+        }
+        writeSeparator();
+        double timestamp = (event.start - originTimestamp) / ticksPerMicrosecond;
+        if (event.duration == INSTANT) {
+            std::fprintf(file, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%d",
+                         names[event.nameId].c_str(), timestamp, threadId);
+        } else {
+            std::fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d",
+                         names[event.nameId].c_str(), timestamp, event.duration / ticksPerMicrosecond, threadId);
+        }
+        if (event.value != NO_VALUE) {
+            std::fprintf(file, ",\"args\":{\"value\":%d}", event.value);
+        }
+        std::fputc('}', file);
+        ++numEvents;
+    }
+
+    size_t drainAll() {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t drained = 0;
+        for (const auto& ring : rings) {
+            int threadId = ring->getThreadId();
+            drained += ring->drain([&](const TraceEvent& event) { writeEvent(threadId, event); });
+        }
+        return drained;
+    }
+
+    void writeLoop() {
+        // Draining in batches keeps the writer off the producers' cache lines between passes
+        while (!stopping) {
+            drainAll();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+};
+
+// RAII scope recorded as one complete event when it closes
+class TraceScope {
+public:
+    TraceScope(uint32_t nameId, int32_t value = NO_VALUE)
+        : nameId(nameId), value(value), start(Tracer::get().isEnabled() ? profiling::readTimestamp() : 0) {}
+
+    ~TraceScope() {
+        if (start != 0 && Tracer::get().isEnabled()) {
+            Tracer::get().getRing().push({start, profiling::readTimestamp() - start, nameId, value});
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    uint32_t nameId;
+    int32_t value;
+    uint64_t start;
+};
+
+inline void recordInstant(uint32_t nameId, int32_t value) {
+    if (Tracer::get().isEnabled()) {
+        Tracer::get().getRing().push({profiling::readTimestamp(), INSTANT, nameId, value});
+    }
+}
+
+} // namespace tracing
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+// Traces the rest of the enclosing scope; the optional second argument is shown as args.value
+#define TRACE_SCOPE(name, ...)                                                                                      \
+    static const uint32_t TRACE_CONCAT(traceNameId, __LINE__) = ::tracing::Tracer::get().getNameId(name);            \
+    ::tracing::TraceScope TRACE_CONCAT(traceScope, __LINE__)(TRACE_CONCAT(traceNameId, __LINE__) __VA_OPT__(, ) __VA_ARGS__)
+#define TRACE_INSTANT(name, value)                                                                                  \
+    do {                                                                                                            \
+        static const uint32_t traceNameId = ::tracing::Tracer::get().getNameId(name);                               \
+        ::tracing::recordInstant(traceNameId, value);                                                               \
+    } while (false)
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <type_traits>
+
+// Work-stealing thread pool shared by the experiment drivers. Every worker owns a deque: jobs
+// submitted from a worker go to the back of its own deque and the owner pops from the back (LIFO,
+// cache-warm), while idle workers steal from the front of a randomly chosen victim (FIFO, oldest
+// and usually largest jobs first). Jobs submitted from outside the pool are spread round-robin.
+// Uneven job sizes therefore rebalance on their own instead of leaving cores idle behind one long
+// job, as a static split or a single queue drained in submission order would.
+class WorkStealingPool {
+public:
+    // Per-worker utilization counters
+    struct WorkerStats {
+        long long jobs = 0;
+        long long steals = 0;
+        double busyTime = 0; // Seconds spent running jobs
+        double idleTime = 0; // Seconds spent looking for or waiting for work
+    };
+
+    WorkStealingPool(int numThreads) : queues(numThreads), stats(numThreads), pendingJobs(0), stopping(false) {
+        for (int i = 0; i < numThreads; ++i) {
+            queues[i] = std::make_unique<WorkerQueue>();
+        }
+        for (int i = 0; i < numThreads; ++i) {
+            workers.emplace_back([this, i] { workLoop(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        sleepCv.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Submits a job and returns its future. Blocking on the future from inside a job ties up that
+    // worker; nested parallelism should use a TaskGroup instead, whose wait() keeps working.
+    template <typename Function>
+    auto submit(Function function) -> std::future<decltype(function())> {
+        typedef decltype(function()) Result;
+        // The task's own future becomes ready inside the job; the caller's only once the worker's
+        // counters are updated
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+        auto result = std::make_shared<std::future<Result>>(task->get_future());
+        auto promise = std::make_shared<std::promise<Result>>();
+        auto future = promise->get_future();
+        push({[task] { (*task)(); },
+              [result, promise] {
+                  try {
+                      if constexpr (std::is_void_v<Result>) {
+                          result->get();
+                          promise->set_value();
+                      } else {
+                          promise->set_value(result->get());
+                      }
+                  } catch (...) {
+                      promise->set_exception(std::current_exception());
+                  }
+              }});
+        return future;
+    }
+
+    // Fork-join scope: run() forks jobs into the pool and wait() joins them. The waiting thread
+    // executes pool jobs while it waits, so groups can nest inside jobs without deadlocking; when
+    // there is nothing to run it spins briefly, then sleeps until a job is pushed or the group ends.
+    class TaskGroup {
+    public:
+        static constexpr int MAX_SPINS = 64;
+
+        TaskGroup(WorkStealingPool& pool) : pool(pool), pending(0) {}
+
+        ~TaskGroup() {
+            wait();
+        }
+
+        template <typename Function>
+        void run(Function function) {
+            ++pending;
+            // finish must not touch the group after the decrement: wait() may return and the group
+            // go out of scope at that moment
+            pool.push({std::move(function), [this, pool = &pool] {
+                           std::lock_guard<std::mutex> lock(pool->sleepMutex);
+                           if (--pending == 0) {
+                               pool->sleepCv.notify_all();
+                           }
+                       }});
+        }
+
+        void wait() {
+            int spins = 0;
+            while (pending > 0) {
+                if (pool.runOneJob()) {
+                    spins = 0;
+                } else if (++spins < MAX_SPINS) {
+                    std::this_thread::yield();
+                } else {
+                    std::unique_lock<std::mutex> lock(pool.sleepMutex);
+                    pool.sleepCv.wait(lock, [this] { return pending == 0 || pool.pendingJobs > 0; });
+                    spins = 0;
+                }
+            }
+        }
+
+    private:
+        WorkStealingPool& pool;
+        std::atomic<int> pending;
+    };
+
+    int getNumThreads() const {
+        return workers.size();
+    }
+
+    // Counters are updated by the workers before a job signals completion, so they are safe to read
+    // once every TaskGroup has been waited on and every future has been waited on
+    const std::vector<WorkerStats>& getStats() const {
+        return stats;
+    }
+
+    void printUtilization() const {
+        std::cout << std::setw(8) << "Worker" << std::setw(12) << "Jobs" << std::setw(12) << "Steals" << std::setw(14)
+                  << "Busy (s)" << std::setw(14) << "Idle (s)" << std::setw(16) << "Utilization" << std::endl;
+        double totalBusy = 0.0;
+        double totalIdle = 0.0;
+        for (int i = 0; i < int(stats.size()); ++i) {
+            const WorkerStats& worker = stats[i];
+            double total = worker.busyTime + worker.idleTime;
+            std::cout << std::setw(8) << i << std::setw(12) << worker.jobs << std::setw(12) << worker.steals
+                      << std::setw(14) << std::fixed << std::setprecision(3) << worker.busyTime << std::setw(14)
+                      << worker.idleTime << std::setw(15) << std::setprecision(1)
+                      << (total > 0 ? 100.0 * worker.busyTime / total : 0.0) << '%' << std::endl;
+            totalBusy += worker.busyTime;
+            totalIdle += worker.idleTime;
+        }
+        double total = totalBusy + totalIdle;
+        std::cout << std::setw(60) << "Total" << std::setw(15) << std::setprecision(1)
+                  << (total > 0 ? 100.0 * totalBusy / total : 0.0) << '%' << std::endl;
+    }
+
+private:
+    // A job's function, and how it signals completion once the worker has recorded it
+    struct Job {
+        std::function<void()> function;
+        std::function<void()> finish;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<WorkerStats> stats;
+    std::atomic<long long> pendingJobs;
+    std::atomic<unsigned> nextQueue{0};
+    std::mutex sleepMutex;
+    std::condition_variable sleepCv;
+    bool stopping;
+
+    // Index of the calling thread in its pool, or -1 outside any pool
+    static int& currentWorker() {
+        static thread_local int worker = -1;
+        return worker;
+    }
+
+    static WorkStealingPool*& currentPool() {
+        static thread_local WorkStealingPool* pool = nullptr;
+        return pool;
+    }
+
+    int getCallerWorker() const {
+        return currentPool() == this ? currentWorker() : -1;
+    }
+
+    void push(Job job) {
+        int worker = getCallerWorker();
+        int target = worker >= 0 ? worker : int(nextQueue++ % queues.size());
+        {
+            std::lock_guard<std::mutex> lock(queues[target]->mutex);
+            queues[target]->jobs.push_back(std::move(job));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            ++pendingJobs;
+        }
+        sleepCv.notify_one();
+    }
+
+    bool popLocal(int worker, Job& job) {
+        WorkerQueue& queue = *queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) {
+            return false;
+        }
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+        --pendingJobs;
+        return true;
+    }
+
+    // Tries every other queue once, starting from a random victim
+    bool steal(int worker, Job& job, std::mt19937& gen) {
+        int numQueues = queues.size();
+        int first = std::uniform_int_distribution<>(0, numQueues - 1)(gen);
+        for (int i = 0; i < numQueues; ++i) {
+            int victim = (first + i) % numQueues;
+            if (victim == worker) continue;
+            WorkerQueue& queue = *queues[victim];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty()) {
+                job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+                --pendingJobs;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Runs one job on behalf of a waiting TaskGroup; returns false if none was available
+    bool runOneJob() {
+        static thread_local std::mt19937 gen(std::random_device{}());
+        int worker = getCallerWorker();
+        Job job;
+        if (worker >= 0 ? popLocal(worker, job) || steal(worker, job, gen) : steal(-1, job, gen)) {
+            runJob(worker, job);
+            return true;
+        }
+        return false;
+    }
+
+    // Jobs run by a waiting TaskGroup inside another job already count towards that job's busy
+    // interval, so only the outermost job on a worker adds busy time
+    void runJob(int worker, Job& job) {
+        static thread_local int depth = 0;
+        if (worker < 0) {
+            job.function();
+            job.finish();
+            return;
+        }
+        auto startTime = std::chrono::steady_clock::now();
+        ++depth;
+        job.function();
+        --depth;
+        if (depth == 0) {
+            auto endTime = std::chrono::steady_clock::now();
+            stats[worker].busyTime += std::chrono::duration<double>(endTime - startTime).count();
+        }
+        ++stats[worker].jobs;
+        job.finish();
+    }
+
+    void workLoop(int worker) {
+        currentWorker() = worker;
+        currentPool() = this;
+        std::mt19937 gen(worker + 1);
+        auto idleStart = std::chrono::steady_clock::now();
+        while (true) {
+            Job job;
+            bool stolen = false;
+            if (popLocal(worker, job) || (stolen = steal(worker, job, gen))) {
+                auto startTime = std::chrono::steady_clock::now();
+                stats[worker].idleTime += std::chrono::duration<double>(startTime - idleStart).count();
+                stats[worker].steals += stolen;
+                runJob(worker, job);
+                idleStart = std::chrono::steady_clock::now();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            if (stopping && pendingJobs == 0) {
+                // Time after the last job is shutdown, not idleness
+                return;
+            }
+            sleepCv.wait(lock, [this] { return stopping || pendingJobs > 0; });
+        }
+    }
+};